@@ -0,0 +1,18 @@
+#version 450
+
+out vec4 frag_color;
+
+in vec3 sun_position;
+in vec3 position;
+in vec3 normal;
+
+const float ambient_strength = 0.1;
+const vec3 sun_color = vec3(1.0, 1.0, 1.0);
+const vec3 albedo = vec3(0.45, 0.42, 0.38);
+
+void main() {
+    vec3 light_dir = normalize(sun_position - position);
+    float diffuse = max(dot(normalize(normal), light_dir), 0.0);
+
+    frag_color = vec4((ambient_strength + diffuse) * sun_color * albedo, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 450
+
+layout(location = 0) in vec3 position_;
+layout(location = 1) in vec3 normal_;
+layout(location = 2) in vec2 tex_coords_;
+
+out vec3 sun_position;
+out vec3 position;
+out vec3 normal;
+
+#include "frame_uniforms.glsl"
+#include "draw_batch.glsl"
+
+void main() {
+    mat4 model = draws.models[draw_id_];
+    vec4 world_position = model * vec4(position_, 1.0);
+
+    gl_ClipDistance[0] = dot(world_position, frame.clipping_plane);
+	gl_Position = frame.projection * frame.view * world_position;
+
+    sun_position = frame.sun_position.xyz;
+    position = world_position.xyz;
+    normal = mat3(model) * normal_;
+}
@@ -0,0 +1,6 @@
+/* Model matrices of the draws of a DrawBatch. Must match DrawBatch::DRAW_ID_LOCATION and DrawBatch::MODEL_BINDING */
+layout(location = 3) in uint draw_id_;
+
+layout(std430, binding = 1) readonly buffer DrawModels {
+    mat4 models[];
+} draws;
@@ -0,0 +1,9 @@
+/* Per-frame data shared by all shaders, written by frame_uniforms. Must match frame_uniforms::Data */
+layout(std140, binding = 0) uniform FrameUniforms {
+    mat4 projection;
+    mat4 view;
+    vec4 camera_position;
+    vec4 clipping_plane;
+    vec4 sun_position;
+    float time;
+} frame;
@@ -0,0 +1,117 @@
+/* Port of HeightGenerator, see src/math/height_generator.h. Generates the same heights for the same seed
+ * and amplitude, up to the rounding of the interpolation, see HeightfieldCompute::TOLERANCE */
+
+/* Order of InterpolationMethod */
+const int INTERPOLATION_COSINE   = 0;
+const int INTERPOLATION_BILINEAR = 1;
+const int INTERPOLATION_BICUBIC  = 2;
+
+const int HEIGHTFIELD_OCTAVES = 3;
+const float PI = 3.14159265358979;
+
+uniform uint ufrm_seed;
+uniform float ufrm_amplitude;
+uniform int ufrm_interpolation;
+/* Uploaded from HeightGenerator rather than recomputed, so that both use the same values */
+uniform float ufrm_octave_frequencies[HEIGHTFIELD_OCTAVES];
+uniform float ufrm_octave_amplitudes[HEIGHTFIELD_OCTAVES];
+
+/* math::hash */
+uint lattice_hash(uint value) {
+    value ^= value >> 16u;
+    value *= 0x7feb352du;
+    value ^= value >> 15u;
+    value *= 0x846ca68bu;
+    value ^= value >> 16u;
+    return value;
+}
+
+uint lattice_hash(uint seed, int x, int z) {
+    return lattice_hash(uint(x) + lattice_hash(uint(z) + lattice_hash(seed)));
+}
+
+/* The upper 24 bits of the hash map exactly onto floats in [-1, 1) */
+float lattice_noise(int x, int z) {
+    precise float value = float(lattice_hash(ufrm_seed, x, z) >> 8u) * (2.0 / 16777216.0) - 1.0;
+    return value * ufrm_amplitude;
+}
+
+/* The third corner is sampled at (x - 1, x + 1), as in HeightGenerator */
+float smooth_noise(int x, int z) {
+    precise float corners = (lattice_noise(x-1, z-1) +
+                             lattice_noise(x+1, z-1) +
+                             lattice_noise(x-1, x+1) +
+                             lattice_noise(x+1, z+1)) / 16.0;
+
+    precise float sides = (lattice_noise(x-1, z) +
+                           lattice_noise(x+1, z) +
+                           lattice_noise(x, z-1) +
+                           lattice_noise(x, z+1)) / 8.0;
+
+    precise float center = lattice_noise(x, z) / 4.0;
+
+    precise float smoothed = corners + sides + center;
+    return smoothed;
+}
+
+float linear(float x, float min_value, float max_value) {
+    return (1.0 - x) * min_value + x * max_value;
+}
+
+float cosine(float x, float min_value, float max_value) {
+    return linear((1.0 - cos(x * PI)) / 2.0, min_value, max_value);
+}
+
+/* Horner's scheme in single precision, as simd_interpolation */
+float cubic(float x, float p0, float p1, float p2, float p3) {
+    float a = -0.5 * p0 + 1.5 * p1 - 1.5 * p2 + 0.5 * p3;
+    float b = p0 - 2.5 * p1 + 2.0 * p2 - 0.5 * p3;
+    float c = -0.5 * p0 + 0.5 * p2;
+
+    return ((a * x + b) * x + c) * x + p1;
+}
+
+float interpolated_noise(float x, float z) {
+    int x_i = int(x);
+    int z_i = int(z);
+
+    float rem_x = x - float(x_i);
+    float rem_z = z - float(z_i);
+
+    if(ufrm_interpolation == INTERPOLATION_BICUBIC) {
+        /* Row z + 1 is read twice, as in HeightGenerator */
+        const int rows[4] = int[4](-1, 0, 1, 1);
+        float interpolated[4];
+
+        for(int k = 0; k < 4; k++) {
+            int z_k = z_i + rows[k];
+            interpolated[k] = cubic(rem_x, smooth_noise(x_i - 1, z_k),
+                                           smooth_noise(x_i, z_k),
+                                           smooth_noise(x_i + 1, z_k),
+                                           smooth_noise(x_i + 2, z_k));
+        }
+
+        return cubic(rem_z, interpolated[0], interpolated[1], interpolated[2], interpolated[3]);
+    }
+
+    float p1_z1 = smooth_noise(x_i, z_i);
+    float p2_z1 = smooth_noise(x_i + 1, z_i);
+    float p1_z2 = smooth_noise(x_i, z_i + 1);
+    float p2_z2 = smooth_noise(x_i + 1, z_i + 1);
+
+    if(ufrm_interpolation == INTERPOLATION_COSINE)
+        return cosine(rem_z, cosine(rem_x, p1_z1, p2_z1), cosine(rem_x, p1_z2, p2_z2));
+
+    return linear(rem_z, linear(rem_x, p1_z1, p2_z1), linear(rem_x, p1_z2, p2_z2));
+}
+
+/* HeightGenerator::generate */
+float generate_height(ivec2 lattice) {
+    float height = 0.0;
+    for(int i = 0; i < HEIGHTFIELD_OCTAVES; i++) {
+        float frequency = ufrm_octave_frequencies[i];
+        height += interpolated_noise(float(lattice.x) * frequency, float(lattice.y) * frequency) * ufrm_octave_amplitudes[i];
+    }
+
+    return height;
+}
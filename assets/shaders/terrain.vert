@@ -1,8 +1,13 @@
 #version 450
 
-layout(location = 0) in vec3 position_;
-layout(location = 1) in vec3 normal_;
-layout(location = 2) in vec2 tex_coords_;
+/* Terrain and ChunkedTerrain supply heights and normals per vertex, see terrain_vertex.glsl. QuadtreeTerrain
+ * sets ufrm_cdlod and draws a grid patch per node instead, sampling the heightmap, see terrain_cdlod.glsl */
+layout(location = 0) in float height_;
+layout(location = 1) in vec2 normal_;
+/* Grid patch position in [0, 1] */
+layout(location = 2) in vec2 patch_position_;
+/* Per node, x and z of the corner, size and level, all in model space */
+layout(location = 3) in vec4 node_;
 
 out vec3 sun_position;
 out vec3 position;
@@ -11,24 +16,31 @@ out vec3 normal;
 
 out float terrain_amplitude;
 
-uniform float ufrm_time;
+#include "frame_uniforms.glsl"
+#include "terrain_cdlod.glsl"
+#include "terrain_vertex.glsl"
 
 uniform mat4 ufrm_model;
-uniform mat4 ufrm_projection;
-uniform mat4 ufrm_view;
-
-uniform vec3 ufrm_sun_position;
 uniform float ufrm_terrain_amplitude;
-
-uniform vec4 ufrm_clipping_plane;
+uniform bool ufrm_cdlod;
 
 void main() {
-    gl_ClipDistance[0] = dot(vec4(position_, 1.0), ufrm_clipping_plane);
-	gl_Position = ufrm_projection * ufrm_view * ufrm_model * vec4(position_, 1.0);
-
-    sun_position = ufrm_sun_position;
-    position = vec3(ufrm_model * vec4(position_, 1.0));
-    camera_view = vec3(ufrm_view[0][3], ufrm_view[1][3], ufrm_view[2][3]);
-    normal = normal_;
+    vec4 local_position;
+    if(ufrm_cdlod) {
+        vec2 xz = cdlod_position(patch_position_, node_);
+        local_position = vec4(xz.x, heightmap_height(xz), xz.y, 1.0);
+        normal = heightmap_normal(xz);
+    }
+    else {
+        local_position = vec4(terrain_position(height_, ufrm_terrain_amplitude), 1.0);
+        normal = terrain_normal(normal_);
+    }
+
+    gl_ClipDistance[0] = dot(local_position, frame.clipping_plane);
+	gl_Position = frame.projection * frame.view * ufrm_model * local_position;
+
+    sun_position = frame.sun_position.xyz;
+    position = vec3(ufrm_model * local_position);
+    camera_view = vec3(frame.view[0][3], frame.view[1][3], frame.view[2][3]);
     terrain_amplitude = ufrm_terrain_amplitude;
 }
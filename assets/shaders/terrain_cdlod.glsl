@@ -0,0 +1,40 @@
+/* Heights and normals sampled from the heightmap of QuadtreeTerrain, for the grid patch drawn once per
+ * selected node. Requires the heightmap to be bound to texture unit 0 */
+
+layout(binding = 0) uniform sampler2D ufrm_heightmap;
+uniform vec2 ufrm_heightmap_origin;
+uniform float ufrm_heightmap_spacing;
+uniform float ufrm_patch_cells;
+
+/* Camera position in model space */
+uniform vec3 ufrm_lod_camera;
+/* Distances at which morphing starts and ends for each level */
+uniform vec2 ufrm_morph_ranges[16];
+
+float heightmap_height(vec2 xz) {
+    vec2 texel = (xz - ufrm_heightmap_origin) / ufrm_heightmap_spacing + 0.5;
+    return textureLod(ufrm_heightmap, texel / vec2(textureSize(ufrm_heightmap, 0)), 0.0).r;
+}
+
+vec3 heightmap_normal(vec2 xz) {
+    float height_left  = heightmap_height(xz - vec2(ufrm_heightmap_spacing, 0.0));
+    float height_right = heightmap_height(xz + vec2(ufrm_heightmap_spacing, 0.0));
+    float height_up    = heightmap_height(xz + vec2(0.0, ufrm_heightmap_spacing));
+    float height_down  = heightmap_height(xz - vec2(0.0, ufrm_heightmap_spacing));
+
+    return normalize(vec3(height_left - height_right, 2.0, height_down - height_up));
+}
+
+/* Position in the xz-plane of the patch vertex at grid, in [0, 1], of node, holding x and z of the corner,
+ * size and level. Odd vertices are moved onto the grid of the next, coarser level as the distance to the
+ * camera grows */
+vec2 cdlod_position(vec2 grid, vec4 node) {
+    vec2 xz = node.xy + grid * node.z;
+
+    vec2 morph_range = ufrm_morph_ranges[int(node.w)];
+    float dist = distance(ufrm_lod_camera, vec3(xz.x, heightmap_height(xz), xz.y));
+    float morph = clamp((dist - morph_range.x) / (morph_range.y - morph_range.x), 0.0, 1.0);
+
+    grid -= fract(grid * ufrm_patch_cells * 0.5) * 2.0 / ufrm_patch_cells * morph;
+    return node.xy + grid * node.z;
+}
@@ -0,0 +1,26 @@
+/* Decoding of terrain_vertex_layout, see src/engine/vertex_layout.h. Requires the vertices to be drawn with
+ * indices into a grid of ufrm_grid_lattice.z vertices per row */
+
+/* Offset and spacing of the lattice in the xz-plane */
+uniform vec4 ufrm_grid;
+/* Lattice coordinates of the first vertex, and the number of vertices per row */
+uniform ivec3 ufrm_grid_lattice;
+
+const float TERRAIN_HEIGHT_RANGE = 2.25;
+
+vec3 terrain_position(float height, float amplitude) {
+    ivec2 lattice = ufrm_grid_lattice.xy + ivec2(gl_VertexID % ufrm_grid_lattice.z, gl_VertexID / ufrm_grid_lattice.z);
+    vec2 xz = ufrm_grid.xy + vec2(lattice) * ufrm_grid.zw;
+
+    return vec3(xz.x, height * TERRAIN_HEIGHT_RANGE * amplitude, xz.y);
+}
+
+/* Octahedral mapping around the y-axis */
+vec3 terrain_normal(vec2 encoded) {
+    vec3 normal = vec3(encoded.x, 1.0 - abs(encoded.x) - abs(encoded.y), encoded.y);
+
+    if(normal.y < 0.0)
+        normal.xz = (1.0 - abs(encoded.yx)) * vec2(encoded.x < 0.0 ? -1.0 : 1.0, encoded.y < 0.0 ? -1.0 : 1.0);
+
+    return normalize(normal);
+}
@@ -0,0 +1,201 @@
+#include "benchmark.h"
+#include "cuboid.h"
+#include "cylinder.h"
+#include "disk_cache.h"
+#include "ellipsoid.h"
+#include "height_generator.h"
+#include "null_gl.h"
+#include "terrain.h"
+#include "tileable_noise.h"
+#include "transform.h"
+#include "vertex_cache.h"
+#include "water.h"
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Times the CPU side of terrain, mesh and noise generation. No context is created, see null_gl.
+ *
+ * Usage: bench [output file] [filter]
+ * Results are written as JSON to output file, or to std::cout if none is given. Only benchmarks
+ * whose names contain filter are run. The ACMR of the meshes before and after vertex cache optimization
+ * is written to std::cerr */
+
+namespace {
+	using HeightGen = HeightGenerator<InterpolationMethod::Bicubic>;
+
+	struct Transformable : Transform { };
+
+	void add_height_generator(benchmark::Suite& suite) {
+		int constexpr size = 256;
+		suite.add("height_generator/generate/256x256", size * size, [] {
+			/* A new generator each iteration, the lattice cache starts out empty */
+			HeightGen generator{10.f};
+			float sum = 0.f;
+			for(auto z = 0; z < size; z++)
+				for(auto x = 0; x < size; x++)
+					sum += generator.generate(x, z);
+			benchmark::do_not_optimize(sum);
+		});
+
+		std::size_t constexpr rows = 512u;
+		for(auto kernel : {HeightKernel::Reference, HeightKernel::Vectorized}) {
+			std::string const name = kernel == HeightKernel::Reference ? "reference" : "vectorized";
+			suite.add("height_generator/generate_rows/" + name + "/512x512", rows * rows, [kernel] {
+				std::vector<float> heights(rows * rows);
+				HeightGen generator{10.f};
+				generator.generate_rows(0, 0, rows, rows, heights.data(), kernel);
+				benchmark::do_not_optimize(heights);
+			});
+		}
+	}
+
+	void add_terrain(benchmark::Suite& suite) {
+		/* 10 x 10 grids, the number of vertices per side is roughly 10 / spacing */
+		for(auto [name, spacing] : {std::pair{"0.1", .1f}, std::pair{"0.05", .05f}, std::pair{"0.025", .025f}}) {
+			GLuint const per_side = static_cast<GLuint>(10.f / spacing) + 1u;
+			suite.add(std::string{"terrain/init/spacing_"} + name, per_side * per_side, [spacing = spacing] {
+				Terrain<manual_shader_handler> terrain{{}, 10.f, 10.f, spacing, 10.f, spacing};
+				benchmark::do_not_optimize(terrain);
+			});
+		}
+	}
+
+	void add_noise(benchmark::Suite& suite) {
+		int constexpr size = 384;
+		suite.add("tileable_noise/generate/384x384", size * size, [] {
+			float sum = 0.f;
+			for(auto y = 0; y < size; y++)
+				for(auto x = 0; x < size; x++)
+					sum += tileable_noise::generate(static_cast<float>(x) / 32.f, static_cast<float>(y) / 32.f, 128u);
+			benchmark::do_not_optimize(sum);
+		});
+
+		suite.add("water/generate_map_data", 1u, [] {
+			auto const data = Water<manual_shader_handler>::generate_map_data();
+			benchmark::do_not_optimize(data);
+		});
+	}
+
+	void add_meshes(benchmark::Suite& suite) {
+		suite.add("ellipsoid/init/60x60", 1u, [] {
+			Ellipsoid<manual_shader_handler> ellipsoid{{}, 60u, 60u};
+			benchmark::do_not_optimize(ellipsoid);
+		});
+
+		suite.add("cylinder/init/60x20", 1u, [] {
+			Cylinder<manual_shader_handler> cylinder{{}, 1.f, 60u, 20u};
+			benchmark::do_not_optimize(cylinder);
+		});
+	}
+
+	void add_vertex_cache(benchmark::Suite& suite) {
+		/* Indices as generated, the reordering is timed on a copy */
+		vertex_cache::set_enabled(false);
+		Terrain<manual_shader_handler> const terrain{{}, 10.f, 10.f, .025f, 10.f, .025f};
+		vertex_cache::set_enabled(true);
+
+		std::vector<GLuint> const indices(terrain.indices(), terrain.indices() + terrain.indices_size());
+		std::size_t const vertex_count = terrain.vertices_size() / terrain_vertex_layout::SIZE;
+
+		suite.add("vertex_cache/optimize/terrain_401x401", indices.size() / 3u, [indices, vertex_count] {
+			auto reordered = indices;
+			vertex_cache::optimize(reordered, vertex_count);
+			benchmark::do_not_optimize(reordered);
+		});
+	}
+
+	void report_acmr(std::string const& name, std::vector<GLuint> indices, std::size_t vertex_count) {
+		auto const statistics = vertex_cache::optimize(indices, vertex_count);
+		std::cerr << std::fixed << std::setprecision(3)
+				  << name << ": ACMR " << statistics.acmr_before << " -> " << statistics.acmr_after << '\n';
+	}
+
+	void report_vertex_cache() {
+		vertex_cache::set_enabled(false);
+		Terrain<manual_shader_handler> const terrain{{}, 10.f, 10.f, .05f, 10.f, .05f};
+		Ellipsoid<manual_shader_handler> const ellipsoid{{}, 60u, 60u};
+		Cylinder<manual_shader_handler> const cylinder{{}, 1.f, 60u, 20u};
+		Cuboid<manual_shader_handler> const cuboid{};
+		vertex_cache::set_enabled(true);
+
+		report_acmr("terrain/201x201", {terrain.indices(), terrain.indices() + terrain.indices_size()}, terrain.vertices_size() / terrain_vertex_layout::SIZE);
+		report_acmr("ellipsoid/60x60", ellipsoid.indices(), ellipsoid.vertices().size() / Ellipsoid<manual_shader_handler>::VERTEX_SIZE);
+		report_acmr("cylinder/60x20", cylinder.indices(), cylinder.vertices().size() / Cylinder<manual_shader_handler>::VERTEX_SIZE);
+		report_acmr("cuboid", cuboid.indices(), cuboid.vertices().size() / Cuboid<manual_shader_handler>::VERTEX_SIZE);
+	}
+
+	void add_transform(benchmark::Suite& suite) {
+		std::size_t constexpr operations = 1'000u;
+		suite.add("transform/translate_rotate_scale", 3u * operations, [] {
+			Transformable transform;
+			for(auto i = 0u; i < operations; i++) {
+				transform.translate(glm::vec3{1.f, 0.f, -1.f});
+				transform.rotate(1.f, Transform::Axis::Y);
+				transform.scale(glm::vec3{1.001f});
+			}
+			benchmark::do_not_optimize(transform);
+		});
+
+		suite.add("transform/model_matrix", operations, [] {
+			Transformable transform;
+			transform.translate(glm::vec3{1.f, 0.f, -1.f});
+			transform.rotate(45.f, Transform::Axis::Y);
+			for(auto i = 0u; i < operations; i++) {
+				auto const model = transform.model_matrix();
+				benchmark::do_not_optimize(model);
+			}
+		});
+
+		suite.add("transform/position", operations, [] {
+			Transformable transform;
+			transform.translate(glm::vec3{1.f, 0.f, -1.f});
+			transform.scale(glm::vec3{2.f});
+			for(auto i = 0u; i < operations; i++) {
+				auto const position = transform.position();
+				benchmark::do_not_optimize(position);
+			}
+		});
+	}
+}
+
+int main(int argc, char* argv[])
+try {
+	null_gl::install();
+
+	/* Measure generation rather than cache hits */
+	disk_cache::set_enabled(false);
+
+	benchmark::Suite suite;
+	add_height_generator(suite);
+	add_terrain(suite);
+	add_noise(suite);
+	add_meshes(suite);
+	add_vertex_cache(suite);
+	add_transform(suite);
+
+	report_vertex_cache();
+
+	auto const results = suite.run(argc > 2 ? argv[2] : "");
+
+	if(argc > 1) {
+		std::ofstream ofs{argv[1]};
+		benchmark::write_json(ofs, results);
+		if(!ofs) {
+			std::cerr << "Could not write results to " << argv[1] << '\n';
+			return 1;
+		}
+	}
+	else
+		benchmark::write_json(std::cout, results);
+
+	return 0;
+}
+catch(std::exception const& err) {
+	std::cerr << "Benchmark terminated after an exception was thrown: " << err.what() << '\n';
+	return 1;
+}
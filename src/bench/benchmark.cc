@@ -0,0 +1,74 @@
+#include "benchmark.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <utility>
+
+void benchmark::Suite::add(std::string name, std::size_t items, std::function<void()> iteration) {
+	benchmarks_.push_back({std::move(name), items, std::move(iteration)});
+}
+
+std::vector<benchmark::Result> benchmark::Suite::run(std::string const& filter) const {
+	std::vector<Result> results;
+	for(auto const& benchmark : benchmarks_) {
+		if(benchmark.name.find(filter) == std::string::npos)
+			continue;
+
+		std::cerr << std::left << std::setw(48) << benchmark.name << std::flush;
+		results.push_back(measure(benchmark));
+
+		auto const& result = results.back();
+		std::cerr << std::right << std::setw(14) << std::fixed << std::setprecision(3) << result.median_ns / 1e6 << " ms"
+				  << std::setw(10) << result.iterations << " iterations\n";
+	}
+
+	return results;
+}
+
+benchmark::Result benchmark::Suite::measure(Benchmark const& benchmark) {
+	using clock = std::chrono::steady_clock;
+
+	/* Warm up caches, lazily initialized state and the thread pool */
+	benchmark.iteration();
+
+	std::vector<double> times;
+	auto const start = clock::now();
+	while(times.size() < MAX_ITERATIONS && (times.size() < MIN_ITERATIONS || clock::now() - start < MIN_DURATION)) {
+		auto const begin = clock::now();
+		benchmark.iteration();
+		auto const end = clock::now();
+		times.push_back(std::chrono::duration<double, std::nano>(end - begin).count());
+	}
+
+	std::sort(std::begin(times), std::end(times));
+	std::size_t const n = times.size();
+	double const median = n % 2u ? times[n / 2u] : (times[n / 2u - 1u] + times[n / 2u]) / 2.0;
+	double const mean = std::accumulate(std::begin(times), std::end(times), 0.0) / static_cast<double>(n);
+
+	return { benchmark.name, n, benchmark.items, times.front(), median, mean, times.back() };
+}
+
+void benchmark::write_json(std::ostream& os, std::vector<Result> const& results) {
+	os << "{\n"
+	   << "  \"threads\": " << ThreadPool::instance().concurrency() << ",\n"
+	   << "  \"benchmarks\": [\n";
+
+	os << std::fixed << std::setprecision(1);
+	for(auto i = 0u; i < results.size(); i++) {
+		auto const& result = results[i];
+		os << "    {\"name\": \"" << result.name << "\""
+		   << ", \"iterations\": " << result.iterations
+		   << ", \"items\": " << result.items
+		   << ", \"min_ns\": " << result.min_ns
+		   << ", \"median_ns\": " << result.median_ns
+		   << ", \"mean_ns\": " << result.mean_ns
+		   << ", \"max_ns\": " << result.max_ns
+		   << ", \"ns_per_item\": " << std::setprecision(3) << result.median_ns / static_cast<double>(std::max<std::size_t>(result.items, 1u))
+		   << std::setprecision(1) << "}" << (i + 1u < results.size() ? ",\n" : "\n");
+	}
+
+	os << "  ]\n"
+	   << "}\n";
+}
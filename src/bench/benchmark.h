@@ -0,0 +1,63 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* Minimal harness for timing CPU code paths. Every benchmark is run until it has completed at least
+ * MIN_ITERATIONS iterations and MIN_DURATION has passed, or until MAX_ITERATIONS iterations have
+ * completed. Each iteration is timed separately, reported times are per iteration */
+namespace benchmark {
+	std::size_t constexpr MIN_ITERATIONS = 5u;
+	std::size_t constexpr MAX_ITERATIONS = 100'000u;
+	std::chrono::milliseconds constexpr MIN_DURATION{500};
+
+	struct Result {
+		std::string name;
+		std::size_t iterations;
+		/* Number of items (samples, vertices, ...) processed per iteration */
+		std::size_t items;
+		double min_ns;
+		double median_ns;
+		double mean_ns;
+		double max_ns;
+	};
+
+	class Suite {
+		public:
+			void add(std::string name, std::size_t items, std::function<void()> iteration);
+
+			/* Runs all benchmarks whose names contain filter, in the order they were added */
+			std::vector<Result> run(std::string const& filter = "") const;
+
+		private:
+			struct Benchmark {
+				std::string name;
+				std::size_t items;
+				std::function<void()> iteration;
+			};
+
+			std::vector<Benchmark> benchmarks_{};
+
+			static Result measure(Benchmark const& benchmark);
+	};
+
+	/* One benchmark per line, in the order given, so that results can be diffed across builds */
+	void write_json(std::ostream& os, std::vector<Result> const& results);
+
+	/* Prevents the compiler from optimizing away the computation of value */
+	template <typename T>
+	void do_not_optimize(T const& value) noexcept;
+}
+
+template <typename T>
+void benchmark::do_not_optimize(T const& value) noexcept {
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "null_gl.h"
+#include <GL/glew.h>
+
+namespace null_gl {
+	GLuint next_name{1u};
+
+	void APIENTRY gen_names(GLsizei count, GLuint* names);
+	void APIENTRY delete_names(GLsizei, GLuint const*) { }
+	void APIENTRY bind_buffer(GLenum, GLuint) { }
+	void APIENTRY bind_vertex_array(GLuint) { }
+	void APIENTRY buffer_data(GLenum, GLsizeiptr, void const*, GLenum) { }
+	void APIENTRY enable_vertex_attrib_array(GLuint) { }
+	void APIENTRY bind_vertex_buffer(GLuint, GLuint, GLintptr, GLsizei) { }
+	void APIENTRY vertex_attrib_format(GLuint, GLint, GLenum, GLboolean, GLuint) { }
+	void APIENTRY vertex_attrib_binding(GLuint, GLuint) { }
+}
+
+void APIENTRY null_gl::gen_names(GLsizei count, GLuint* names) {
+	for(auto i = 0; i < count; i++)
+		names[i] = next_name++;
+}
+
+void null_gl::install() noexcept {
+	glGenVertexArrays = gen_names;
+	glGenBuffers = gen_names;
+	glDeleteVertexArrays = delete_names;
+	glDeleteBuffers = delete_names;
+	glBindVertexArray = bind_vertex_array;
+	glBindBuffer = bind_buffer;
+	glBufferData = buffer_data;
+	glEnableVertexAttribArray = enable_vertex_attrib_array;
+	glBindVertexBuffer = bind_vertex_buffer;
+	glVertexAttribFormat = vertex_attrib_format;
+	glVertexAttribBinding = vertex_attrib_binding;
+}
@@ -0,0 +1,13 @@
+#ifndef NULL_GL_H
+#define NULL_GL_H
+
+#pragma once
+
+/* Points the OpenGL entry points used when constructing and destroying renderables at functions that
+ * do nothing, so that meshes can be built without a context. Object names are still handed out.
+ * Only for programs that never create a context, must be called before any renderable is constructed */
+namespace null_gl {
+	void install() noexcept;
+}
+
+#endif
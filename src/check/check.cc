@@ -0,0 +1,251 @@
+#include "buffer_policy.h"
+#include "height_generator.h"
+#include "heightfield_compute.h"
+#include "renderer.h"
+#include "ring_buffer.h"
+#include "shader_handler.h"
+#include "simd_interpolation.h"
+#include "suite.h"
+#include "vertex_layout.h"
+#include "window.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <GL/glew.h>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Verifies results that must hold across builds and machines. Checks whose names start with gpu/ render
+ * to a headless window, see Context, the others do not require a context.
+ *
+ * Usage: check [filter]
+ * Only checks whose names contain filter are run. Returns non-zero if any check fails */
+
+namespace {
+	using HeightGen = HeightGenerator<InterpolationMethod::Bicubic>;
+
+	struct Region {
+		int x0;
+		int z0;
+		std::size_t width;
+		std::size_t height;
+	};
+
+	/* Negative and positive origins, and widths that do not fill an entire SIMD register */
+	Region constexpr REGIONS[] = { {    0,     0,  64u, 16u },
+								   {  -37,   -91, 157u, 23u },
+								   { 1234, -4321,  83u, 19u },
+								   { -2049,  513, 200u,  9u } };
+
+	std::string describe(std::uint32_t seed, float amplitude, Region const& region) {
+		std::ostringstream os;
+		os << "seed " << seed << ", amplitude " << amplitude << ", origin (" << region.x0 << ", " << region.z0 << ")";
+		return os.str();
+	}
+
+	void add_height_generator(check::Suite& suite) {
+		suite.add("height_generator/generate_rows/reference_matches_generate", [] {
+			for(auto const& region : REGIONS) {
+				HeightGen generator{10.f};
+				std::vector<float> heights(region.width * region.height);
+				generator.generate_rows(region.x0, region.z0, region.width, region.height, heights.data());
+
+				HeightGen sampler{10.f};
+				for(auto r = 0u; r < region.height; r++) {
+					for(auto c = 0u; c < region.width; c++) {
+						float const expected = sampler.generate(region.x0 + static_cast<int>(c), region.z0 + static_cast<int>(r));
+						check::expect(heights[r * region.width + c] == expected, "Reference kernel differs from generate, " + describe(HeightGen::DEFAULT_SEED, 10.f, region));
+					}
+				}
+			}
+		});
+
+		suite.add("height_generator/generate_rows/vectorized_within_tolerance", [] {
+			for(auto seed : {HeightGen::DEFAULT_SEED, 1u, 0xdeadbeefu}) {
+				for(auto amplitude : {1.f, 10.f, 250.f}) {
+					for(auto const& region : REGIONS) {
+						std::size_t const size = region.width * region.height;
+						std::vector<float> reference(size), vectorized(size);
+
+						HeightGen generator{amplitude, seed};
+						generator.generate_rows(region.x0, region.z0, region.width, region.height, reference.data(), HeightKernel::Reference);
+						generator.generate_rows(region.x0, region.z0, region.width, region.height, vectorized.data(), HeightKernel::Vectorized);
+
+						float difference = 0.f;
+						for(auto i = 0u; i < size; i++)
+							difference = std::max(difference, std::abs(reference[i] - vectorized[i]));
+
+						std::ostringstream os;
+						os << "Kernels differ by " << difference << ", " << describe(seed, amplitude, region);
+						check::expect(difference <= simd_interpolation::TOLERANCE * amplitude, os.str());
+					}
+				}
+			}
+		});
+	}
+
+	void add_terrain_vertex_layout(check::Suite& suite) {
+		suite.add("terrain_vertex_layout/height_range_covers_generator", [] {
+			/* The weights of the cubic at t sum to 1 + t - t^2 in magnitude, at most 1.25 */
+			float bound = 0.f;
+			for(auto amplitude : HeightGen::amplitudes())
+				bound += 1.25f * 1.25f * amplitude;
+
+			std::ostringstream os;
+			os << "Heights may reach " << bound << " times the amplitude, beyond the range of " << terrain_vertex_layout::HEIGHT_RANGE;
+			check::expect(bound <= terrain_vertex_layout::HEIGHT_RANGE, os.str());
+
+			for(auto amplitude : {1.f, 10.f, 250.f}) {
+				/* Half a step of the GL_SHORT, plus rounding */
+				float const tolerance = .51f * terrain_vertex_layout::HEIGHT_RANGE * amplitude / 32767.f;
+				auto round_trips = [amplitude, tolerance](float height) {
+					GLshort vertex[terrain_vertex_layout::SIZE];
+					terrain_vertex_layout::encode(height, amplitude, glm::vec3{0.f, 1.f, 0.f}, vertex);
+					return std::abs(terrain_vertex_layout::decode_height(vertex, amplitude) - height) <= tolerance;
+				};
+
+				for(auto height : {-bound * amplitude, bound * amplitude})
+					check::expect(round_trips(height), "Largest possible height " + std::to_string(height) + " is clamped, amplitude " + std::to_string(amplitude));
+
+				for(auto const& region : REGIONS) {
+					HeightGen generator{amplitude};
+					std::vector<float> heights(region.width * region.height);
+					generator.generate_rows(region.x0, region.z0, region.width, region.height, heights.data());
+
+					check::expect(std::all_of(std::begin(heights), std::end(heights), round_trips),
+								  "Heights do not round-trip through the vertex layout, " + describe(HeightGen::DEFAULT_SEED, amplitude, region));
+				}
+			}
+		});
+	}
+
+	/* Created by the first check that requires a context, and kept for the remaining ones */
+	void require_context() {
+		static Window const window{"check", 64u, 64u, 4.5f, false};
+		static_cast<void>(window);
+	}
+
+	/* Quad whose vertices are rewritten every frame, as by any per-frame vertex producer */
+	class StreamedQuad : public Renderer<StreamedQuad, manual_shader_handler, dynamic_buffer> {
+		using renderer_t = Renderer<StreamedQuad, manual_shader_handler, dynamic_buffer>;
+		public:
+			StreamedQuad() : renderer_t{} {
+				renderer_t::init();
+			}
+
+			void init() { }
+
+			std::vector<GLfloat> const& vertices() const {
+				return vertices_;
+			}
+
+			std::vector<GLuint> const& indices() const {
+				return indices_;
+			}
+
+			/* Moves the quad to height and writes it to the next region of the ring buffer */
+			void set_height(GLfloat height) {
+				for(auto i = 1u; i < vertices_.size(); i += float_vertex_layout::SIZE)
+					vertices_[i] = height;
+				update_vertices();
+			}
+
+			/* The vertices a draw issued now would read, and the offset they are read from */
+			std::pair<std::vector<GLfloat>, GLint64> bound_vertices() const {
+				GLint buffer = 0;
+				GLint64 offset = 0;
+				bind();
+				glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, 0u, &buffer);
+				glGetInteger64i_v(GL_VERTEX_BINDING_OFFSET, 0u, &offset);
+				unbind();
+
+				std::vector<GLfloat> bound(vertices_.size());
+				glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(buffer));
+				glGetBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bound.size() * sizeof(GLfloat)), bound.data());
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+				return {bound, offset};
+			}
+
+		private:
+			std::vector<GLfloat> vertices_{ -1.f, 0.f, -1.f,  0.f, 1.f, 0.f,  0.f, 0.f,
+											 1.f, 0.f, -1.f,  0.f, 1.f, 0.f,  1.f, 0.f,
+											-1.f, 0.f,  1.f,  0.f, 1.f, 0.f,  0.f, 1.f,
+											 1.f, 0.f,  1.f,  0.f, 1.f, 0.f,  1.f, 1.f };
+			std::vector<GLuint> indices_{ 0u, 1u, 2u, 2u, 1u, 3u };
+	};
+
+	/* Every region is generated with every seed and amplitude, with the shader compiled once per method */
+	template <InterpolationMethod IM>
+	void add_heightfield_compute(check::Suite& suite, std::string const& method) {
+		suite.add("gpu/heightfield_compute/" + method + "_within_tolerance", [] {
+			require_context();
+			auto const shader = std::make_shared<Shader>("assets/shaders/heightfield.comp", Shader::Type::Compute);
+
+			for(auto seed : {HeightGenerator<IM>::DEFAULT_SEED, 1u, 0xdeadbeefu}) {
+				for(auto amplitude : {1.f, 10.f, 250.f}) {
+					HeightfieldCompute<IM> heightfield{shader, amplitude, seed};
+					for(auto const& region : REGIONS) {
+						auto const difference = heightfield.verify(region.x0, region.z0, static_cast<GLuint>(region.width), static_cast<GLuint>(region.height));
+
+						std::ostringstream os;
+						os << "Heights differ by " << difference.height << " and normals by " << difference.normal << ", " << describe(seed, amplitude, region);
+						check::expect(heightfield.within_tolerance(difference), os.str());
+					}
+				}
+			}
+		});
+	}
+
+	void add_dynamic_buffer(check::Suite& suite) {
+		suite.add("gpu/renderer/dynamic_buffer_streams_every_frame", [] {
+			require_context();
+
+			StreamedQuad quad;
+			std::vector<GLint64> offsets;
+
+			/* Enough frames for every region to be reused while its fence may still be pending */
+			for(auto frame = 0u; frame < 4u * RingBuffer::REGIONS; frame++) {
+				auto const height = static_cast<GLfloat>(frame) + .5f;
+				quad.set_height(height);
+
+				auto const [bound, offset] = quad.bound_vertices();
+				check::expect(bound == quad.vertices(), "Frame " + std::to_string(frame) + " does not read the vertices written for it");
+
+				if(frame)
+					check::expect(offset != offsets.back(), "Frame " + std::to_string(frame) + " reads the region written by the previous frame");
+				if(frame >= RingBuffer::REGIONS)
+					check::expect(offset == offsets[frame - RingBuffer::REGIONS], "Regions are not reused in order");
+				offsets.push_back(offset);
+
+				quad.render();
+			}
+
+			glFinish();
+			check::expect(glGetError() == GL_NO_ERROR, "Streaming the vertices raised a GL error");
+		});
+	}
+}
+
+int main(int argc, char* argv[])
+try {
+	check::Suite suite;
+	add_height_generator(suite);
+	add_terrain_vertex_layout(suite);
+	add_dynamic_buffer(suite);
+	add_heightfield_compute<InterpolationMethod::Cosine>(suite, "cosine");
+	add_heightfield_compute<InterpolationMethod::Bilinear>(suite, "bilinear");
+	add_heightfield_compute<InterpolationMethod::Bicubic>(suite, "bicubic");
+
+	return suite.run(argc > 1 ? argv[1] : "") ? 1 : 0;
+}
+catch(std::exception const& err) {
+	std::cerr << "Checks terminated after an exception was thrown: " << err.what() << '\n';
+	return 1;
+}
@@ -0,0 +1,37 @@
+#include "suite.h"
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+void check::expect(bool condition, std::string const& message) {
+	if(!condition)
+		throw Failure{message};
+}
+
+void check::Suite::add(std::string name, std::function<void()> check) {
+	checks_.push_back({std::move(name), std::move(check)});
+}
+
+std::size_t check::Suite::run(std::string const& filter) const {
+	std::size_t ran = 0u, failed = 0u;
+	for(auto const& check : checks_) {
+		if(check.name.find(filter) == std::string::npos)
+			continue;
+
+		std::cerr << std::left << std::setw(64) << check.name << std::flush;
+		ran++;
+
+		try {
+			check.body();
+			std::cerr << "ok\n";
+		}
+		catch(std::exception const& err) {
+			std::cerr << "FAILED\n    " << err.what() << '\n';
+			failed++;
+		}
+	}
+
+	std::cerr << ran - failed << " of " << ran << " checks passed\n";
+	return failed;
+}
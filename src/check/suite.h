@@ -0,0 +1,39 @@
+#ifndef SUITE_H
+#define SUITE_H
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Minimal harness for the checks run by make check. A check passes if it returns without throwing, and
+ * fails on any exception. expect throws Failure, so that a check stops at the first unmet expectation */
+namespace check {
+	class Failure : public std::runtime_error {
+		public:
+			using std::runtime_error::runtime_error;
+	};
+
+	void expect(bool condition, std::string const& message);
+
+	class Suite {
+		public:
+			void add(std::string name, std::function<void()> check);
+
+			/* Runs all checks whose names contain filter, in the order they were added. Returns the
+			 * number of checks that failed */
+			std::size_t run(std::string const& filter = "") const;
+
+		private:
+			struct Check {
+				std::string name;
+				std::function<void()> body;
+			};
+
+			std::vector<Check> checks_{};
+	};
+}
+
+#endif
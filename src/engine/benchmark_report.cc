@@ -0,0 +1,85 @@
+#include "benchmark_report.h"
+#include "logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace benchmark_report {
+	double percentile(std::vector<double> const& sorted, double fraction);
+	std::string escaped(std::string const& str);
+}
+
+benchmark_report::FrameStatistics benchmark_report::compute(std::vector<double> milliseconds) {
+	if(milliseconds.empty())
+		return { 0u, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+	std::sort(std::begin(milliseconds), std::end(milliseconds));
+	double const total = std::accumulate(std::begin(milliseconds), std::end(milliseconds), 0.0);
+
+	return { milliseconds.size(),
+			 milliseconds.front(),
+			 total / static_cast<double>(milliseconds.size()),
+			 percentile(milliseconds, 0.5),
+			 percentile(milliseconds, 0.95),
+			 percentile(milliseconds, 0.99),
+			 milliseconds.back() };
+}
+
+std::string benchmark_report::summary(FrameStatistics const& statistics) {
+	std::ostringstream os;
+	os << std::fixed << std::setprecision(3)
+	   << statistics.frames << " frames, min " << statistics.min_ms << " ms, avg " << statistics.average_ms
+	   << " ms, p50 " << statistics.p50_ms << " ms, p95 " << statistics.p95_ms << " ms, p99 " << statistics.p99_ms
+	   << " ms, max " << statistics.max_ms << " ms";
+	return os.str();
+}
+
+bool benchmark_report::write(std::filesystem::path const& path, FrameStatistics const& statistics, std::vector<gpu_profiler::PassTime> const& passes, std::string const& renderer) {
+	std::ofstream ofs{path, std::ios::trunc};
+	ofs << std::fixed << std::setprecision(4)
+		<< "{\n"
+		<< "  \"renderer\": \"" << escaped(renderer) << "\",\n"
+		<< "  \"warmup_frames\": " << WARMUP_FRAMES << ",\n"
+		<< "  \"frames\": " << statistics.frames << ",\n"
+		<< "  \"frame_ms\": {"
+		<< "\"min\": " << statistics.min_ms
+		<< ", \"avg\": " << statistics.average_ms
+		<< ", \"p50\": " << statistics.p50_ms
+		<< ", \"p95\": " << statistics.p95_ms
+		<< ", \"p99\": " << statistics.p99_ms
+		<< ", \"max\": " << statistics.max_ms << "},\n"
+		<< "  \"gpu_pass_ms\": [";
+
+	for(auto i = 0u; i < passes.size(); i++) {
+		ofs << (i ? ",\n" : "\n")
+			<< "    {\"name\": \"" << escaped(passes[i].name) << "\", \"avg\": " << passes[i].run_average_ms
+			<< ", \"samples\": " << passes[i].run_samples << '}';
+	}
+	ofs << (passes.empty() ? "]\n" : "\n  ]\n") << "}\n";
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write benchmark report to ", path.string());
+		return false;
+	}
+
+	return true;
+}
+
+double benchmark_report::percentile(std::vector<double> const& sorted, double fraction) {
+	auto const rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+	return sorted[std::clamp<std::size_t>(rank, 1u, sorted.size()) - 1u];
+}
+
+std::string benchmark_report::escaped(std::string const& str) {
+	std::string result;
+	result.reserve(str.size());
+	for(auto c : str) {
+		if(c == '"' || c == '\\')
+			result.push_back('\\');
+		result.push_back(c);
+	}
+	return result;
+}
@@ -0,0 +1,36 @@
+#ifndef BENCHMARK_REPORT_H
+#define BENCHMARK_REPORT_H
+
+#pragma once
+#include "gpu_profiler.h"
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/* Summary of a flythrough benchmark, see RunOptions */
+namespace benchmark_report {
+	/* Frames that are rendered before measuring starts, while caches and drivers settle */
+	std::size_t constexpr WARMUP_FRAMES = 30u;
+
+	struct FrameStatistics {
+		std::size_t frames;
+		double min_ms;
+		double average_ms;
+		double p50_ms;
+		double p95_ms;
+		double p99_ms;
+		double max_ms;
+	};
+
+	/* Percentiles use the nearest rank */
+	FrameStatistics compute(std::vector<double> milliseconds);
+
+	std::string summary(FrameStatistics const& statistics);
+
+	/* Writes the frame statistics and the average GPU time of every pass over the run as JSON.
+	 * Returns false on failure */
+	bool write(std::filesystem::path const& path, FrameStatistics const& statistics, std::vector<gpu_profiler::PassTime> const& passes, std::string const& renderer);
+}
+
+#endif
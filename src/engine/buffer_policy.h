@@ -0,0 +1,18 @@
+#ifndef BUFFER_POLICY_H
+#define BUFFER_POLICY_H
+
+#pragma once
+
+/* Policies deciding how Renderer stores vertices on the GPU */
+
+/* Vertices are uploaded once, in init */
+struct static_buffer { };
+
+/* Vertices are stored in a persistently mapped RingBuffer and may be replaced every frame through
+ * Renderer::update_vertices, without stalling on frames in flight. The vertices may not grow beyond
+ * the size they had in init */
+struct dynamic_buffer {
+	static bool constexpr is_dynamic = true;
+};
+
+#endif
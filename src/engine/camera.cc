@@ -1,7 +1,7 @@
 #include "frametime.h"
 #include "camera.h"
+#include "frame_uniforms.h"
 #include "logger.h"
-#include "shader.h"
 #include "type_conversion.h"
 #include <cmath>
 
@@ -23,12 +23,7 @@ void Camera::rotate(double delta_x, double delta_y) {
 	pitch_ += delta_y * (invert_y_ ? -1.f : 1.f);
 	pitch_ = glm::clamp(pitch_, -89.f, 89.f);
 
-	local_z_.x = std::cos(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
-	local_z_.y = std::sin(glm::radians(pitch_));
-	local_z_.z = std::sin(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
-	local_z_ = glm::normalize(local_z_);
-
-	compute_local_xy();
+	compute_local_axes();
 	update_view();
 }
 
@@ -102,6 +97,21 @@ glm::mat4 Camera::view() const {
 	return view_;
 }
 
+void Camera::set_projection(glm::mat4 const& projection) {
+	projection_ = projection;
+	has_projection_ = true;
+	frame_uniforms::set_projection(projection_);
+	update_view();
+}
+
+glm::mat4 Camera::projection() const {
+	return projection_;
+}
+
+Frustum const& Camera::frustum() const {
+	return frustum_;
+}
+
 ClipSpace Camera::clip_space() const {
 	return clip_space_;
 }
@@ -114,7 +124,10 @@ void Camera::set_position(glm::vec3 pos) {
     LOG("Setting camera position {", pos.x, ", ", pos.y, ", ", pos.z, "}");
     position_ = pos;
     update_view();
-    Shader::template upload_to_all<true>(Shader::VIEW_UNIFORM_NAME, view());
+}
+
+float Camera::yaw() const {
+    return yaw_;
 }
 
 float Camera::pitch() const {
@@ -126,14 +139,8 @@ void Camera::set_pitch(float pitch) {
     pitch_ = pitch;
 	pitch_ = glm::clamp(pitch_, -89.f, 89.f);
 
-	local_z_.x = std::cos(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
-	local_z_.y = std::sin(glm::radians(pitch_));
-	local_z_.z = std::sin(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
-	local_z_ = glm::normalize(local_z_);
-
-	compute_local_xy();
+	compute_local_axes();
 	update_view();
-    Shader::template upload_to_all<true>(Shader::VIEW_UNIFORM_NAME, view());
 }
 
 void Camera::invert_pitch() {
@@ -141,10 +148,28 @@ void Camera::invert_pitch() {
     set_pitch(-pitch_);
 }
 
+void Camera::set_pose(glm::vec3 position, float yaw, float pitch) {
+    position_ = position;
+    yaw_ = yaw;
+    pitch_ = glm::clamp(pitch, -89.f, 89.f);
+
+    compute_local_axes();
+    update_view();
+}
+
 glm::vec3 Camera::view_direction() const {
     return -local_z_;
 }
 
+void Camera::compute_local_axes() {
+	local_z_.x = std::cos(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
+	local_z_.y = std::sin(glm::radians(pitch_));
+	local_z_.z = std::sin(glm::radians(yaw_)) * std::cos(glm::radians(pitch_));
+	local_z_ = glm::normalize(local_z_);
+
+	compute_local_xy();
+}
+
 void Camera::compute_local_xy(){
 	local_x_ = glm::normalize(glm::cross(glm::vec3(0.f, 1.f, 0.f), local_z_));
 	local_y_ = glm::cross(local_z_, local_x_);
@@ -152,4 +177,10 @@ void Camera::compute_local_xy(){
 
 void Camera::update_view() {
 	view_ = glm::lookAt(position_, position_ - local_z_, glm::vec3{0.f, 1.f, 0.f});
+	frame_uniforms::set_view(view_, position_);
+
+	if(has_projection_) {
+		frustum_ = Frustum{projection_ * view_};
+		Frustum::set_active(frustum_);
+	}
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "bitmask.h"
+#include "frustum.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -68,15 +69,24 @@ class Camera {
 		float fov() const;
 		glm::mat4 view() const;
 
+		/* The camera's view and projection are the ones in frame_uniforms. Setting the projection makes the
+		 * camera's frustum the one objects are culled against */
+		void set_projection(glm::mat4 const& projection);
+		glm::mat4 projection() const;
+		Frustum const& frustum() const;
+
 		ClipSpace clip_space() const;
         
         glm::vec3 position();
         void set_position(glm::vec3 pos);
 
+        float yaw() const;
         float pitch() const;
         void set_pitch(float pitch);
         void invert_pitch();
 
+        void set_pose(glm::vec3 position, float yaw, float pitch);
+
         glm::vec3 view_direction() const;
 
 	private:
@@ -85,6 +95,9 @@ class Camera {
 		glm::vec3 local_y_;
 		glm::vec3 local_z_;
 		glm::mat4 view_;
+		glm::mat4 projection_{1.f};
+		Frustum frustum_{};
+		bool has_projection_{false};
 		float fov_;
 		float yaw_;
 		float pitch_;
@@ -98,6 +111,7 @@ class Camera {
 
 		void init(glm::vec3 target_view);
 
+		void compute_local_axes();
 		void compute_local_xy();
 		void update_view();
 };
@@ -0,0 +1,124 @@
+#include "camera_path.h"
+#include "constants.h"
+#include "exception.h"
+#include "interpolation.h"
+#include "logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+CameraPath::CameraPath(std::vector<Keyframe> keyframes) : keyframes_{std::move(keyframes)} {
+	if(keyframes_.size() < 2u)
+		throw InvalidArgumentException{"Camera path requires at least two keyframes"};
+
+	for(auto i = 1u; i < keyframes_.size(); i++) {
+		if(!(keyframes_[i].time > keyframes_[i - 1u].time))
+			throw InvalidArgumentException{"Camera path keyframe times must be strictly increasing"};
+
+		/* Turn the shortest way, e.g. from 350 to 10 degrees through 360 */
+		float const turn = keyframes_[i].yaw - keyframes_[i - 1u].yaw;
+		keyframes_[i].yaw -= 360.f * std::round(turn / 360.f);
+	}
+}
+
+CameraPath::Keyframe CameraPath::at(float time) const {
+	float const start = keyframes_.front().time;
+	time = start + std::fmod(time, duration());
+	if(time < start)
+		time += duration();
+
+	auto const next = std::upper_bound(std::begin(keyframes_), std::end(keyframes_), time, [](float t, Keyframe const& keyframe) {
+		return t < keyframe.time;
+	});
+	std::size_t const i1 = std::clamp<std::size_t>(static_cast<std::size_t>(next - std::begin(keyframes_)), 1u, keyframes_.size() - 1u);
+	std::size_t const i0 = i1 - 1u;
+
+	/* The end points are repeated for the outer control points */
+	auto const& p0 = keyframes_[i0 ? i0 - 1u : i0];
+	auto const& p1 = keyframes_[i0];
+	auto const& p2 = keyframes_[i1];
+	auto const& p3 = keyframes_[std::min(i1 + 1u, keyframes_.size() - 1u)];
+
+	float const x = std::clamp((time - p1.time) / (p2.time - p1.time), 0.f, 1.f);
+	auto spline = [x](float v0, float v1, float v2, float v3) {
+		return static_cast<float>(interpolation::cubic(x, v0, v1, v2, v3));
+	};
+
+	return { time,
+			 { spline(p0.position.x, p1.position.x, p2.position.x, p3.position.x),
+			   spline(p0.position.y, p1.position.y, p2.position.y, p3.position.y),
+			   spline(p0.position.z, p1.position.z, p2.position.z, p3.position.z) },
+			 spline(p0.yaw, p1.yaw, p2.yaw, p3.yaw),
+			 spline(p0.pitch, p1.pitch, p2.pitch, p3.pitch) };
+}
+
+void CameraPath::apply(Camera& camera, float time) const {
+	auto const pose = at(time);
+	camera.set_pose(pose.position, pose.yaw, pose.pitch);
+}
+
+float CameraPath::duration() const noexcept {
+	return keyframes_.back().time - keyframes_.front().time;
+}
+
+CameraPath CameraPath::orbit(glm::vec3 center, float radius, float height, float period) {
+	/* Pitching down towards the center, see Camera::rotate */
+	float const pitch = glm::degrees(std::atan2(height, radius));
+
+	std::vector<Keyframe> keyframes;
+	keyframes.reserve(ORBIT_KEYFRAMES + 1u);
+	for(auto i = 0u; i <= ORBIT_KEYFRAMES; i++) {
+		float const fraction = static_cast<float>(i) / static_cast<float>(ORBIT_KEYFRAMES);
+		float const angle = 2.f * math::PI * fraction;
+
+		keyframes.push_back({ fraction * period,
+							  center + glm::vec3{radius * std::cos(angle), height, radius * std::sin(angle)},
+							  glm::degrees(angle),
+							  pitch });
+	}
+
+	return CameraPath{std::move(keyframes)};
+}
+
+CameraPath CameraPath::load(std::filesystem::path const& path) {
+	std::ifstream ifs{path};
+	if(!ifs.is_open())
+		throw FileIOException{"Unable to open camera path " + path.string()};
+
+	std::vector<Keyframe> keyframes;
+	std::string line;
+	for(std::size_t line_number = 1u; std::getline(ifs, line); line_number++) {
+		if(line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream is{line};
+		Keyframe keyframe{};
+		if(!(is >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.yaw >> keyframe.pitch))
+			throw InvalidArgumentException{"Malformed keyframe on line " + std::to_string(line_number) + " of " + path.string()};
+
+		keyframes.push_back(keyframe);
+	}
+
+	LOG("Loaded camera path with ", keyframes.size(), " keyframes from ", path.string());
+	return CameraPath{std::move(keyframes)};
+}
+
+bool CameraPath::write(std::filesystem::path const& path, std::vector<Keyframe> const& keyframes) {
+	std::ofstream ofs{path, std::ios::trunc};
+	ofs << "# time x y z yaw pitch\n" << std::fixed << std::setprecision(5);
+	for(auto const& keyframe : keyframes) {
+		ofs << keyframe.time << ' '
+			<< keyframe.position.x << ' ' << keyframe.position.y << ' ' << keyframe.position.z << ' '
+			<< keyframe.yaw << ' ' << keyframe.pitch << '\n';
+	}
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write camera path to ", path.string());
+		return false;
+	}
+
+	return true;
+}
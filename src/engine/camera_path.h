@@ -0,0 +1,46 @@
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#pragma once
+#include "camera.h"
+#include <filesystem>
+#include <vector>
+
+/* Camera poses over time, interpolated between keyframes using Catmull-Rom splines. The path loops,
+ * times past its duration wrap around to the start.
+ *
+ * Stored as text, one keyframe per line holding the time in seconds, the position, the yaw and the
+ * pitch in degrees, separated by whitespace. Lines starting with # are ignored */
+class CameraPath {
+	public:
+		struct Keyframe {
+			float time;
+			glm::vec3 position;
+			float yaw;
+			float pitch;
+		};
+
+		/* Throws InvalidArgumentException if there are fewer than two keyframes or if
+		 * their times are not strictly increasing */
+		explicit CameraPath(std::vector<Keyframe> keyframes);
+
+		Keyframe at(float time) const;
+		void apply(Camera& camera, float time) const;
+
+		float duration() const noexcept;
+
+		/* A full circle around center, looking at it, over period seconds */
+		static CameraPath orbit(glm::vec3 center, float radius, float height, float period);
+
+		/* Throws FileIOException if the file cannot be read and InvalidArgumentException if it is malformed */
+		static CameraPath load(std::filesystem::path const& path);
+		/* Returns false on failure */
+		static bool write(std::filesystem::path const& path, std::vector<Keyframe> const& keyframes);
+
+	private:
+		std::vector<Keyframe> keyframes_;
+
+		static std::size_t constexpr ORBIT_KEYFRAMES = 16u;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include "exception.h"
 #include "logger.h"
 #include <cmath>
+#include <cstdlib>
 #include <functional>
 
 
@@ -9,7 +10,7 @@ Context::Context(std::string const& name, std::size_t width, std::size_t height,
 	init(Type::Secondary, name, shared);
 } 
 
-Context::Context(std::string const& name, std::size_t width, std::size_t height, float version) : context_{nullptr}, width_{width}, height_{height}, is_visible_{true} {
+Context::Context(std::string const& name, std::size_t width, std::size_t height, float version, bool visible) : context_{nullptr}, width_{width}, height_{height}, is_visible_{visible} {
 	init(Type::Primary, name, false, version);
 }
 
@@ -30,6 +31,10 @@ std::size_t Context::height() const {
 	return height_;
 }
 
+bool Context::is_visible() const {
+	return is_visible_;
+}
+
 Context::operator GLFWwindow*() const {
 	return context_;
 }
@@ -39,15 +44,33 @@ void Context::set_dimensions(std::size_t width, std::size_t height) {
 	height_ = height;
 }
 
+bool Context::display_available() {
+	return std::getenv("DISPLAY") || std::getenv("WAYLAND_DISPLAY");
+}
+
 void Context::init(Type type, std::string const& name, bool shared, float version) {
 	LOG("Creating ", (is_visible_ ? "visible" : "invisible"), " context");
 	if(!primary_) {
 		if(type != Type::Primary)
 			throw OutOfOrderInitializationException{"Primary context must be created before any secondary ones"};
 
+		bool const offscreen = !is_visible_ && !display_available();
+		if(offscreen) {
+#ifdef GLFW_PLATFORM_NULL
+			LOG("No display available, using the null platform and OSMesa");
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+			throw ContextCreationException{"Headless rendering without a display requires GLFW 3.4 or later"};
+#endif
+		}
+
 		if(!glfwInit())
 			throw GLException{"Failed to initialize GLFW"};
 
+		/* Hints persist, secondary contexts are created through OSMesa as well */
+		if(offscreen)
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
 		LOG("Context type is primary");
 	}
 
@@ -20,6 +20,7 @@ class Context {
 		static Context const* primary();
 		std::size_t width() const;
 		std::size_t height() const;
+		bool is_visible() const;
 
 		explicit operator GLFWwindow*() const;
 
@@ -29,12 +30,15 @@ class Context {
 
 		enum class Type { Primary, Secondary };
 
-		Context(std::string const& name, std::size_t width, std::size_t height, float version = 4.5f);
+		/* An invisible primary context is headless. If no display is available, it is created on GLFW's
+		 * null platform with an OSMesa context (GLFW 3.4 or later, rendered in software by Mesa) */
+		Context(std::string const& name, std::size_t width, std::size_t height, float version = 4.5f, bool visible = true);
 	private:
 		bool is_visible_{true};
 		static Context* primary_;
 
 		void set_dimensions(std::size_t width, std::size_t height);
+		static bool display_available();
 		
 		void init(Type type, std::string const& name, bool shared, float version = -1.f);
 };
@@ -0,0 +1,169 @@
+#include "cpu_profiler.h"
+#include "logger.h"
+
+namespace cpu_profiler {
+	std::filesystem::path trace_file{};
+}
+
+std::filesystem::path const cpu_profiler::DEFAULT_TRACE_FILE{"cpu_trace.json"};
+
+bool cpu_profiler::write() {
+	return write(trace_file.empty() ? DEFAULT_TRACE_FILE : trace_file);
+}
+
+void cpu_profiler::set_trace_file(std::filesystem::path const& path) {
+	trace_file = path;
+}
+
+#ifdef PROFILE_CPU
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+namespace cpu_profiler {
+	std::size_t constexpr CHUNK_EVENTS = 4096u;
+
+	struct Event {
+		char const* name;
+		std::int64_t begin;
+		std::int64_t end;
+	};
+
+	struct Chunk {
+		std::array<Event, CHUNK_EVENTS> events{};
+		/* Number of events that are fully written, only stored to by the owning thread */
+		std::atomic<std::size_t> size{0u};
+		std::atomic<Chunk*> next{nullptr};
+	};
+
+	struct ThreadBuffer {
+		std::uint32_t id{0u};
+		std::atomic<char const*> name{nullptr};
+		Chunk head{};
+		/* Only accessed by the owning thread */
+		Chunk* tail{&head};
+		ThreadBuffer* next{nullptr};
+	};
+
+	/* Buffers are never freed, so that zones of threads that have exited are still written */
+	std::atomic<ThreadBuffer*> buffers{nullptr};
+	std::atomic<std::uint32_t> thread_count{0u};
+	thread_local ThreadBuffer* thread_buffer{nullptr};
+
+	ThreadBuffer& buffer();
+	std::chrono::steady_clock::time_point epoch() noexcept;
+	void write_escaped(std::ostream& os, char const* str);
+}
+
+void cpu_profiler::set_thread_name(char const* name) {
+	buffer().name.store(name, std::memory_order_release);
+}
+
+std::int64_t cpu_profiler::now() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch()).count();
+}
+
+void cpu_profiler::record(char const* name, std::int64_t begin, std::int64_t end) {
+	auto& thread = buffer();
+	auto* chunk = thread.tail;
+	auto size = chunk->size.load(std::memory_order_relaxed);
+
+	if(size == CHUNK_EVENTS) {
+		auto* next = new Chunk{};
+		chunk->next.store(next, std::memory_order_release);
+		thread.tail = chunk = next;
+		size = 0u;
+	}
+
+	chunk->events[size] = { name, begin, end };
+	chunk->size.store(size + 1u, std::memory_order_release);
+}
+
+bool cpu_profiler::write(std::filesystem::path const& path) {
+	std::ofstream ofs{path, std::ios::trunc};
+	ofs << "{\"traceEvents\":[" << std::fixed << std::setprecision(3);
+
+	bool first = true;
+	auto separator = [&]() {
+		ofs << (first ? "\n" : ",\n");
+		first = false;
+	};
+
+	std::size_t events = 0u;
+	for(auto* thread = buffers.load(std::memory_order_acquire); thread; thread = thread->next) {
+		if(auto const* name = thread->name.load(std::memory_order_acquire)) {
+			separator();
+			ofs << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id << ",\"args\":{\"name\":\"";
+			write_escaped(ofs, name);
+			ofs << "\"}}";
+		}
+
+		for(auto const* chunk = &thread->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+			auto const size = chunk->size.load(std::memory_order_acquire);
+			for(auto i = 0u; i < size; i++) {
+				auto const& event = chunk->events[i];
+				separator();
+				ofs << "{\"name\":\"";
+				write_escaped(ofs, event.name);
+				/* Timestamps are in microseconds */
+				ofs << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->id
+					<< ",\"ts\":" << static_cast<double>(event.begin) / 1e3
+					<< ",\"dur\":" << static_cast<double>(event.end - event.begin) / 1e3 << '}';
+			}
+			events += size;
+		}
+	}
+
+	ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write CPU trace to ", path.string());
+		return false;
+	}
+
+	LOG("Wrote ", events, " CPU zones to ", path.string());
+	return true;
+}
+
+cpu_profiler::ThreadBuffer& cpu_profiler::buffer() {
+	if(thread_buffer)
+		return *thread_buffer;
+
+	thread_buffer = new ThreadBuffer{};
+	thread_buffer->id = thread_count.fetch_add(1u, std::memory_order_relaxed) + 1u;
+
+	/* Lock-free push onto the list of buffers */
+	thread_buffer->next = buffers.load(std::memory_order_relaxed);
+	while(!buffers.compare_exchange_weak(thread_buffer->next, thread_buffer, std::memory_order_release, std::memory_order_relaxed))
+		;
+
+	return *thread_buffer;
+}
+
+std::chrono::steady_clock::time_point cpu_profiler::epoch() noexcept {
+	/* Function local, as threads started during static initialization may record zones */
+	static auto const start = std::chrono::steady_clock::now();
+	return start;
+}
+
+void cpu_profiler::write_escaped(std::ostream& os, char const* str) {
+	for(; *str; str++) {
+		if(*str == '"' || *str == '\\')
+			os << '\\';
+		os << *str;
+	}
+}
+
+#else
+
+bool cpu_profiler::write(std::filesystem::path const& path) {
+	ERR_LOG_WARN("Unable to write CPU trace to ", path.string(), ", CPU profiling requires PROFILE_CPU to be defined");
+	return false;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+/* Wall-clock time spent in named scopes, on any thread, exported as Chrome trace events
+ * (chrome://tracing, ui.perfetto.dev).
+ *
+ * Every thread records into its own buffer, which is only ever appended to by that thread. Buffers are
+ * made of fixed size chunks that are linked in as they fill up, so recording never blocks and never
+ * drops events. A finished zone is published with a single release store, write may therefore be
+ * called at any time and from any thread, and sees every zone that had ended by then.
+ *
+ * Only compiled in if PROFILE_CPU is defined, otherwise PROFILE_ZONE and PROFILE_THREAD expand to
+ * nothing and write only reports that profiling is unavailable. Zone and thread names must be string
+ * literals, or otherwise outlive the profiler, as only the pointers are stored */
+
+#ifdef PROFILE_CPU
+
+#define CPU_PROFILER_CONCAT_IMPL(a, b) a##b
+#define CPU_PROFILER_CONCAT(a, b) CPU_PROFILER_CONCAT_IMPL(a, b)
+
+/* Measures the rest of the enclosing scope */
+#define PROFILE_ZONE(name) cpu_profiler::Zone const CPU_PROFILER_CONCAT(cpu_profiler_zone_, __LINE__){name}
+/* Names the calling thread in the trace */
+#define PROFILE_THREAD(name) cpu_profiler::set_thread_name(name)
+
+#else
+
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD(name)
+
+#endif
+
+namespace cpu_profiler {
+	#ifdef PROFILE_CPU
+	bool constexpr ENABLED = true;
+	#else
+	bool constexpr ENABLED = false;
+	#endif
+
+	/* Writes every zone recorded so far, on all threads. Returns false on failure */
+	bool write(std::filesystem::path const& path);
+	/* Writes to the trace file, DEFAULT_TRACE_FILE unless set otherwise */
+	bool write();
+	void set_trace_file(std::filesystem::path const& path);
+
+	extern std::filesystem::path const DEFAULT_TRACE_FILE;
+
+	#ifdef PROFILE_CPU
+	/* Allocates the calling thread's buffer if it has none yet */
+	void set_thread_name(char const* name);
+
+	/* Nanoseconds since the profiler was first used */
+	std::int64_t now() noexcept;
+	void record(char const* name, std::int64_t begin, std::int64_t end);
+
+	class Zone {
+		public:
+			explicit Zone(char const* name) noexcept : name_{name}, begin_{now()} { }
+			~Zone() { record(name_, begin_, now()); }
+
+			Zone(Zone const&) = delete;
+			Zone& operator=(Zone const&) = delete;
+
+		private:
+			char const* const name_;
+			std::int64_t const begin_;
+	};
+	#endif
+}
+
+#endif
@@ -0,0 +1,329 @@
+#include "disk_cache.h"
+#include "logger.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace disk_cache {
+	struct FileHeader {
+		std::array<char, 8> magic;
+		std::uint32_t version;
+		std::uint32_t sections;
+		std::uint64_t key_size;
+	};
+
+	std::array<char, 8> constexpr MAGIC{'T', 'E', 'R', 'C', 'A', 'C', 'H', 'E'};
+	std::size_t constexpr SECTION_ALIGNMENT = 16u;
+
+	std::atomic<bool> enabled_{true};
+
+	/* Bytes held by the cache directory, measured by the first store */
+	std::mutex size_mutex_;
+	std::optional<std::uintmax_t> size_{};
+
+	std::filesystem::path directory();
+	void account(std::uintmax_t stored);
+	std::uintmax_t evict(std::uintmax_t target);
+	std::filesystem::path file_path(Key const& key);
+	std::size_t align(std::size_t offset, std::size_t alignment) noexcept;
+}
+
+disk_cache::Key::Key(std::string name) : name_{std::move(name)} { }
+
+disk_cache::Key& disk_cache::Key::add(std::string const& parameter) {
+	add(static_cast<std::uint64_t>(parameter.size()));
+	bytes_.insert(std::end(bytes_), std::begin(parameter), std::end(parameter));
+	return *this;
+}
+
+std::string const& disk_cache::Key::name() const noexcept {
+	return name_;
+}
+
+std::vector<unsigned char> const& disk_cache::Key::bytes() const noexcept {
+	return bytes_;
+}
+
+std::uint64_t disk_cache::Key::hash() const noexcept {
+	/* 64-bit FNV-1a */
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+	auto accumulate = [&hash](unsigned char byte) {
+		hash ^= byte;
+		hash *= 0x100000001b3ull;
+	};
+
+	std::for_each(std::begin(name_), std::end(name_), accumulate);
+	std::for_each(std::begin(bytes_), std::end(bytes_), accumulate);
+
+	return hash;
+}
+
+disk_cache::Entry::Entry(unsigned char const* data, std::size_t size, std::vector<SectionHeader> sections) noexcept
+: data_{data}, size_{size}, sections_{std::move(sections)} { }
+
+disk_cache::Entry::Entry(Entry&& other) noexcept : data_{other.data_}, size_{other.size_}, sections_{std::move(other.sections_)} {
+	other.data_ = nullptr;
+	other.size_ = 0u;
+}
+
+disk_cache::Entry& disk_cache::Entry::operator=(Entry&& other) noexcept {
+	if(this != &other) {
+		unmap();
+		data_ = other.data_;
+		size_ = other.size_;
+		sections_ = std::move(other.sections_);
+		other.data_ = nullptr;
+		other.size_ = 0u;
+	}
+	return *this;
+}
+
+disk_cache::Entry::~Entry() {
+	unmap();
+}
+
+std::size_t disk_cache::Entry::sections() const noexcept {
+	return sections_.size();
+}
+
+std::pair<void const*, std::size_t> disk_cache::Entry::section(std::size_t idx, std::size_t element_size) const noexcept {
+	if(idx >= sections_.size() || sections_[idx].element_size != element_size)
+		return { nullptr, 0u };
+
+	return { data_ + sections_[idx].offset, static_cast<std::size_t>(sections_[idx].size) };
+}
+
+void disk_cache::Entry::unmap() noexcept {
+	if(data_)
+		munmap(const_cast<unsigned char*>(data_), size_);
+	data_ = nullptr;
+	size_ = 0u;
+}
+
+std::optional<disk_cache::Entry> disk_cache::load(Key const& key) {
+	if(!enabled())
+		return std::nullopt;
+
+	auto const path = file_path(key);
+
+	int const fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return std::nullopt;
+
+	struct stat status;
+	if(fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(FileHeader)) {
+		close(fd);
+		return std::nullopt;
+	}
+
+	std::size_t const size = static_cast<std::size_t>(status.st_size);
+	void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(address == MAP_FAILED)
+		return std::nullopt;
+
+	auto const* data = static_cast<unsigned char const*>(address);
+	auto reject = [address, size, &path]() {
+		LOG("Ignoring invalid or outdated cache entry ", path.string());
+		munmap(address, size);
+		return std::nullopt;
+	};
+
+	FileHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if(header.magic != MAGIC)
+		return reject();
+	if(header.version != VERSION)
+		return reject();
+
+	auto const& key_bytes = key.bytes();
+	std::size_t offset = sizeof(FileHeader);
+	if(header.key_size != key_bytes.size() || size < offset + key_bytes.size() ||
+	   !std::equal(std::begin(key_bytes), std::end(key_bytes), data + offset))
+		return reject();
+
+	offset = align(offset + key_bytes.size(), alignof(SectionHeader));
+	if(size < offset + header.sections * sizeof(SectionHeader))
+		return reject();
+
+	std::vector<SectionHeader> sections(header.sections);
+	std::memcpy(sections.data(), data + offset, sections.size() * sizeof(SectionHeader));
+
+	for(auto const& section : sections)
+		if(section.offset % SECTION_ALIGNMENT || section.offset > size || section.size > size - section.offset)
+			return reject();
+
+	madvise(address, size, MADV_WILLNEED);
+
+	/* Marks the entry as recently used for eviction */
+	utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+
+	LOG("Loaded cache entry ", path.string());
+	return Entry{data, size, std::move(sections)};
+}
+
+bool disk_cache::store(Key const& key, std::vector<Section> const& sections) {
+	namespace fs = std::filesystem;
+
+	if(!enabled())
+		return false;
+
+	/* Streaming threads may store concurrently, creating a directory that already exists is not an error */
+	if(std::error_code err{}; !fs::create_directories(directory(), err) && (err || !fs::is_directory(directory()))) {
+		ERR_LOG_WARN("Could not create cache directory: ", err ? err.message() : directory().string() + " is not a directory");
+		return false;
+	}
+
+	auto const path = file_path(key);
+	auto tmp_path = path;
+	tmp_path += ".tmp";
+
+	auto const& key_bytes = key.bytes();
+	FileHeader const header{MAGIC, VERSION, static_cast<std::uint32_t>(sections.size()), key_bytes.size()};
+
+	/* Compute the layout up front, sections are aligned to SECTION_ALIGNMENT */
+	std::size_t const headers_offset = align(sizeof(FileHeader) + key_bytes.size(), alignof(SectionHeader));
+	std::size_t offset = align(headers_offset + sections.size() * sizeof(SectionHeader), SECTION_ALIGNMENT);
+
+	std::vector<SectionHeader> section_headers;
+	section_headers.reserve(sections.size());
+	for(auto const& section : sections) {
+		section_headers.push_back({offset, section.size, section.element_size});
+		offset = align(offset + section.size, SECTION_ALIGNMENT);
+	}
+
+	{
+		std::ofstream ofs{tmp_path, std::ios::binary | std::ios::trunc};
+		std::size_t written = 0u;
+		auto write = [&ofs, &written](void const* data, std::size_t size) {
+			ofs.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+			written += size;
+		};
+		auto pad_to = [&write, &written](std::size_t target) {
+			std::array<char, SECTION_ALIGNMENT> constexpr padding{};
+			while(written < target)
+				write(padding.data(), std::min(padding.size(), target - written));
+		};
+
+		write(&header, sizeof(header));
+		write(key_bytes.data(), key_bytes.size());
+		pad_to(headers_offset);
+		write(section_headers.data(), section_headers.size() * sizeof(SectionHeader));
+
+		for(auto i = 0u; i < sections.size(); i++) {
+			pad_to(section_headers[i].offset);
+			write(sections[i].data, sections[i].size);
+		}
+
+		if(!ofs) {
+			ERR_LOG_WARN("Could not write cache entry ", tmp_path.string());
+			std::error_code err{};
+			fs::remove(tmp_path, err);
+			return false;
+		}
+	}
+
+	/* Readers either see the previous entry or the complete new one */
+	std::error_code err{};
+	fs::rename(tmp_path, path, err);
+	if(err) {
+		ERR_LOG_WARN("Could not store cache entry ", path.string(), ": ", err.message());
+		fs::remove(tmp_path, err);
+		return false;
+	}
+
+	LOG("Stored cache entry ", path.string());
+	account(offset); /* End of the last section, the file size up to its padding */
+	return true;
+}
+
+void disk_cache::set_enabled(bool enabled) noexcept {
+	enabled_.store(enabled);
+}
+
+bool disk_cache::enabled() noexcept {
+	return enabled_.load();
+}
+
+std::filesystem::path disk_cache::directory() {
+	auto dir = std::filesystem::current_path();
+	dir += "/cache/";
+	return dir;
+}
+
+/* Overwritten entries are counted twice until the next eviction measures the directory again, which at
+ * worst evicts early */
+void disk_cache::account(std::uintmax_t stored) {
+	std::lock_guard<std::mutex> lock{size_mutex_};
+	if(!size_)
+		size_ = evict(MAX_SIZE);
+	else
+		*size_ += stored;
+
+	if(*size_ > MAX_SIZE)
+		size_ = evict(EVICTED_SIZE);
+}
+
+/* Removes the least recently used entries until at most target bytes remain, returns the bytes remaining */
+std::uintmax_t disk_cache::evict(std::uintmax_t target) {
+	namespace fs = std::filesystem;
+
+	struct File {
+		fs::path path;
+		fs::file_time_type used;
+		std::uintmax_t size;
+	};
+
+	std::vector<File> files;
+	std::uintmax_t size = 0u;
+	std::error_code err{};
+	for(fs::directory_iterator it{directory(), err}, end; !err && it != end; it.increment(err)) {
+		if(it->path().extension() != ".bin")
+			continue;
+
+		std::error_code file_err{};
+		File file{it->path(), it->last_write_time(file_err), it->file_size(file_err)};
+		if(!file_err) {
+			size += file.size;
+			files.push_back(std::move(file));
+		}
+	}
+
+	if(size <= target)
+		return size;
+
+	std::sort(std::begin(files), std::end(files), [](File const& lhs, File const& rhs) { return lhs.used < rhs.used; });
+	for(auto it = std::begin(files); it != std::end(files) && size > target; ++it) {
+		if(fs::remove(it->path, err)) {
+			LOG("Evicted cache entry ", it->path.string());
+			size -= it->size;
+		}
+	}
+
+	return size;
+}
+
+std::filesystem::path disk_cache::file_path(Key const& key) {
+	std::ostringstream name;
+	name << key.name() << '-' << std::hex << std::setw(16) << std::setfill('0') << key.hash() << ".bin";
+	return directory() / name.str();
+}
+
+std::size_t disk_cache::align(std::size_t offset, std::size_t alignment) noexcept {
+	return (offset + alignment - 1u) / alignment * alignment;
+}
@@ -0,0 +1,127 @@
+#ifndef DISK_CACHE_H
+#define DISK_CACHE_H
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Versioned binary cache for generated data, stored in cache/ in the working directory.
+ * An entry is identified by a Key, built from every parameter that affects the data, and holds
+ * any number of sections of trivially copyable elements. Entries are memory-mapped when loaded and
+ * their sections are read in place.
+ *
+ * The cache is best effort. Entries that are missing, were written by another VERSION or for other
+ * parameters are reported as not found, and failing to store an entry is not an error.
+ *
+ * The cache holds at most MAX_SIZE bytes of entries. A store that exceeds it evicts the least recently
+ * used entries, by modification time, which load refreshes, until at most EVICTED_SIZE bytes remain.
+ * The size is measured once per process and then tracked by the stores, so entries written by other
+ * processes in the meantime are only accounted for at the next eviction */
+namespace disk_cache {
+	std::uint32_t constexpr VERSION = 1u;
+	std::uintmax_t constexpr MAX_SIZE = 256ull << 20u;
+	std::uintmax_t constexpr EVICTED_SIZE = MAX_SIZE / 4u * 3u;
+
+	class Key {
+		public:
+			explicit Key(std::string name);
+
+			template <typename T>
+			Key& add(T const& parameter);
+			/* Prefixed by its length, so that consecutive strings cannot run into each other */
+			Key& add(std::string const& parameter);
+
+			std::string const& name() const noexcept;
+			std::vector<unsigned char> const& bytes() const noexcept;
+			std::uint64_t hash() const noexcept;
+
+		private:
+			std::string name_;
+			std::vector<unsigned char> bytes_{};
+	};
+
+	struct Section {
+		void const* data;
+		std::size_t size;
+		std::size_t element_size;
+	};
+
+	/* Location of a section within a cache file */
+	struct SectionHeader {
+		std::uint64_t offset;
+		std::uint64_t size;
+		std::uint64_t element_size;
+	};
+
+	template <typename T>
+	Section section(T const* data, std::size_t count) noexcept;
+
+	template <typename T>
+	Section section(std::vector<T> const& data) noexcept;
+
+	class Entry {
+		public:
+			Entry(Entry const&) = delete;
+			Entry& operator=(Entry const&) = delete;
+			Entry(Entry&& other) noexcept;
+			Entry& operator=(Entry&& other) noexcept;
+			~Entry();
+
+			std::size_t sections() const noexcept;
+
+			/* Pointer to and number of elements in section idx. {nullptr, 0} if there is no such section
+			 * or if it was stored with elements of a different size */
+			template <typename T>
+			std::pair<T const*, std::size_t> section(std::size_t idx) const noexcept;
+
+			friend std::optional<Entry> load(Key const& key);
+		private:
+			unsigned char const* data_{nullptr};
+			std::size_t size_{0u};
+			std::vector<SectionHeader> sections_{};
+
+			Entry(unsigned char const* data, std::size_t size, std::vector<SectionHeader> sections) noexcept;
+
+			std::pair<void const*, std::size_t> section(std::size_t idx, std::size_t element_size) const noexcept;
+			void unmap() noexcept;
+	};
+
+	std::optional<Entry> load(Key const& key);
+	bool store(Key const& key, std::vector<Section> const& sections);
+
+	/* The cache is enabled by default. While disabled, load finds nothing and store writes nothing */
+	void set_enabled(bool enabled) noexcept;
+	bool enabled() noexcept;
+}
+
+template <typename T>
+disk_cache::Key& disk_cache::Key::add(T const& parameter) {
+	static_assert(std::is_trivially_copyable_v<T>, "Cache key parameters must be trivially copyable");
+	auto const* bytes = reinterpret_cast<unsigned char const*>(&parameter);
+	bytes_.insert(std::end(bytes_), bytes, bytes + sizeof(T));
+	return *this;
+}
+
+template <typename T>
+disk_cache::Section disk_cache::section(T const* data, std::size_t count) noexcept {
+	static_assert(std::is_trivially_copyable_v<T>, "Cached data must be trivially copyable");
+	return { data, count * sizeof(T), sizeof(T) };
+}
+
+template <typename T>
+disk_cache::Section disk_cache::section(std::vector<T> const& data) noexcept {
+	return section(data.data(), data.size());
+}
+
+template <typename T>
+std::pair<T const*, std::size_t> disk_cache::Entry::section(std::size_t idx) const noexcept {
+	auto const [data, size] = section(idx, sizeof(T));
+	return { static_cast<T const*>(data), size / sizeof(T) };
+}
+
+#endif
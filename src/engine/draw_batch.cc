@@ -0,0 +1,125 @@
+#include "draw_batch.h"
+#include "exception.h"
+#include "frustum.h"
+#include "logger.h"
+#include <numeric>
+
+DrawBatch::DrawBatch(std::shared_ptr<Shader> shader) : shader_{std::move(shader)} {
+	glGenVertexArrays(1, &vao_);
+	glGenBuffers(1, &vbo_);
+	glGenBuffers(1, &ibo_);
+	glGenBuffers(1, &command_buffer_);
+	glGenBuffers(1, &model_buffer_);
+	glGenBuffers(1, &draw_id_buffer_);
+
+	glBindVertexArray(vao_);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_);
+
+	auto constexpr VALUE_TYPE_SIZE = sizeof(GLfloat);
+
+	glEnableVertexAttribArray(0); /* Position */
+	glEnableVertexAttribArray(1); /* Normal */
+	glEnableVertexAttribArray(2); /* Texture */
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)(3 * VALUE_TYPE_SIZE));
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)(6 * VALUE_TYPE_SIZE));
+
+	/* One value per instance, starting at the base instance of the draw, which is its id */
+	glBindBuffer(GL_ARRAY_BUFFER, draw_id_buffer_);
+	glEnableVertexAttribArray(DRAW_ID_LOCATION);
+	glVertexAttribIPointer(DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+	glVertexAttribDivisor(DRAW_ID_LOCATION, 1u);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+DrawBatch::~DrawBatch() {
+	glDeleteVertexArrays(1, &vao_);
+	for(auto buffer : { vbo_, ibo_, command_buffer_, model_buffer_, draw_id_buffer_ })
+		glDeleteBuffers(1, &buffer);
+}
+
+DrawBatch::draw_id DrawBatch::add(GLfloat const* vertices, std::size_t vertices_size, GLuint const* indices, std::size_t indices_size, glm::mat4 const& model) {
+	if(vertices_size % VERTEX_SIZE)
+		throw InvalidArgumentException{"Size of vertices is not a multiple of the vertex size"};
+
+	commands_.push_back({ static_cast<GLuint>(indices_size),
+						  1u,
+						  static_cast<GLuint>(indices_.size()),
+						  static_cast<GLint>(vertices_.size() / VERTEX_SIZE),
+						  static_cast<GLuint>(commands_.size()) });
+	models_.push_back(model);
+	bounds_.push_back(AABB::from_vertices(vertices, vertices_size, VERTEX_SIZE));
+
+	vertices_.insert(std::end(vertices_), vertices, vertices + vertices_size);
+	indices_.insert(std::end(indices_), indices, indices + indices_size);
+
+	geometry_dirty_ = models_dirty_ = true;
+	return commands_.size() - 1u;
+}
+
+void DrawBatch::set_model(draw_id id, glm::mat4 const& model) {
+	models_[id] = model;
+	models_dirty_ = true;
+}
+
+std::size_t DrawBatch::size() const noexcept {
+	return commands_.size();
+}
+
+void DrawBatch::render() const {
+	if(geometry_dirty_)
+		upload_geometry();
+
+	if(models_dirty_) {
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, model_buffer_);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::mat4) * models_.size(), models_.data(), GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		models_dirty_ = false;
+	}
+
+	visible_.clear();
+	for(auto i = 0u; i < commands_.size(); i++) {
+		if(Frustum::active().intersects(bounds_[i].transformed(models_[i])))
+			visible_.push_back(commands_[i]);
+	}
+
+	if(visible_.empty())
+		return;
+
+	shader_->enable();
+	glBindVertexArray(vao_);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MODEL_BINDING, model_buffer_);
+
+	/* Only the visible draws are uploaded, which is a small write compared to the geometry */
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawCommand) * visible_.size(), visible_.data(), GL_STREAM_DRAW);
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(visible_.size()), 0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void DrawBatch::upload_geometry() const {
+	LOG("Uploading ", commands_.size(), " draws with ", vertices_.size() / VERTEX_SIZE, " vertices to batch");
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices_.size(), vertices_.data(), GL_STATIC_DRAW);
+
+	std::vector<GLuint> ids(commands_.size());
+	std::iota(std::begin(ids), std::end(ids), 0u);
+	glBindBuffer(GL_ARRAY_BUFFER, draw_id_buffer_);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * ids.size(), ids.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	/* The element array binding is part of the vertex array */
+	glBindVertexArray(vao_);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indices_.size(), indices_.data(), GL_STATIC_DRAW);
+	glBindVertexArray(0);
+
+	geometry_dirty_ = false;
+}
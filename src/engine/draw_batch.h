@@ -0,0 +1,88 @@
+#ifndef DRAW_BATCH_H
+#define DRAW_BATCH_H
+
+#pragma once
+#include "aabb.h"
+#include "shader.h"
+#include "transform.h"
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/* Static geometry of any number of objects sharing a shader and the vertex layout of Renderer, drawn with a
+ * single glMultiDrawElementsIndirect. The vertices and indices of every object are suballocated from one
+ * vertex and one index buffer, and every object is a separate draw whose model matrix is read from a shader
+ * storage buffer bound to MODEL_BINDING. The vertex shader finds the matrix through the draw id passed as an
+ * instanced attribute, see assets/shaders/draw_batch.glsl.
+ *
+ * Draws are culled individually against Frustum::active(). Adding geometry reuploads the buffers on the
+ * next render, so batches should be built once, while model matrices may be changed at any time */
+class DrawBatch {
+	public:
+		using draw_id = std::size_t;
+
+		static GLuint constexpr VERTEX_SIZE = 8u;
+		static GLuint constexpr MODEL_BINDING = 1u;
+		static GLuint constexpr DRAW_ID_LOCATION = 3u;
+
+		explicit DrawBatch(std::shared_ptr<Shader> shader);
+		~DrawBatch();
+
+		DrawBatch(DrawBatch const&) = delete;
+		DrawBatch& operator=(DrawBatch const&) = delete;
+
+		/* Copies the geometry of an object fulfilling the Renderer criteria, using its model
+		 * matrix if it is transformable. Later changes to the object do not affect the batch */
+		template <typename T>
+		draw_id add(T const& object);
+		draw_id add(GLfloat const* vertices, std::size_t vertices_size, GLuint const* indices, std::size_t indices_size, glm::mat4 const& model = glm::mat4{1.f});
+
+		void set_model(draw_id id, glm::mat4 const& model);
+
+		std::size_t size() const noexcept;
+
+		void render() const;
+
+	private:
+		/* Layout defined by glMultiDrawElementsIndirect */
+		struct DrawCommand {
+			GLuint count;
+			GLuint instance_count;
+			GLuint first_index;
+			GLint base_vertex;
+			GLuint base_instance;
+		};
+
+		std::shared_ptr<Shader> shader_;
+		std::vector<GLfloat> vertices_{};
+		std::vector<GLuint> indices_{};
+		std::vector<DrawCommand> commands_{};
+		std::vector<glm::mat4> models_{};
+		std::vector<AABB> bounds_{};				/* In model space */
+		std::vector<DrawCommand> mutable visible_{};
+
+		GLuint vao_{0u}, vbo_{0u}, ibo_{0u};
+		GLuint command_buffer_{0u}, model_buffer_{0u}, draw_id_buffer_{0u};
+		bool mutable geometry_dirty_{false};
+		bool mutable models_dirty_{false};
+
+		void upload_geometry() const;
+};
+
+template <typename T>
+DrawBatch::draw_id DrawBatch::add(T const& object) {
+	auto const& vertices = object.vertices();
+	auto const& indices = object.indices();
+
+	glm::mat4 model{1.f};
+	if constexpr(std::is_base_of_v<Transform, T>)
+		model = object.model_matrix();
+
+	return add(std::data(vertices), std::size(vertices), std::data(indices), std::size(indices), model);
+}
+
+#endif
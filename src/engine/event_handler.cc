@@ -1,5 +1,6 @@
 #include "blur.h"
 #include "context.h"
+#include "cpu_profiler.h"
 #include "event_handler.h"
 #include "exception.h"
 #include "framebuffer.h"
@@ -26,7 +27,6 @@ void EventHandler::instantiate(std::shared_ptr<Camera> const& camera) {
 
 	instance_ = &handler;
 	update_perspective();
-	update_view();
 }
 
 void EventHandler::init() {
@@ -55,13 +55,8 @@ void EventHandler::update_perspective() {
 									static_cast<float>(context->width())/static_cast<float>(context->height()), 
 									near, 
 									far);
-	
-	Shader::template upload_to_all<true>(Shader::PROJECTION_UNIFORM_NAME, perspective);
-}
 
-void EventHandler::update_view() {
-	glm::mat4 const view = instance_->camera_->view();
-	Shader::template upload_to_all<true>(Shader::VIEW_UNIFORM_NAME, view);
+	instance_->camera_->set_projection(perspective);
 }
 
 void EventHandler::key_callback(GLFWwindow*, int key, int, int action, int mod_bits) {
@@ -126,9 +121,13 @@ void EventHandler::key_callback(GLFWwindow*, int key, int, int action, int mod_b
             else
                 camera->set_state(Speed::Slow);
             break;
+        case GLFW_KEY_F9:
+            if constexpr(cpu_profiler::ENABLED) {
+                if(action == GLFW_PRESS)
+                    cpu_profiler::write();
+            }
+            break;
     }
-
-    update_view();
 }
 
 
@@ -139,7 +138,6 @@ void EventHandler::mouse_callback(GLFWwindow*, double x, double y) {
 	instance_->camera_->rotate(static_cast<float>(delta_x), static_cast<float>(delta_y));
 
 	mouse_position_ = { x, y };
-	update_view();
 }
 
 void EventHandler::size_callback(GLFWwindow*, int width, int height) {
@@ -41,7 +41,6 @@ class EventHandler {
 		void init();
 
 		static void update_perspective();
-		static void update_view();
 
 		static void key_callback(GLFWwindow*, int key, int, int action, int mod_bits);
 		static void mouse_callback(GLFWwindow*, double x, double y);
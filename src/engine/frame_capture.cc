@@ -0,0 +1,162 @@
+#include "frame_capture.h"
+#include "logger.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <GL/glew.h>
+#include <iomanip>
+#include <string>
+
+namespace frame_capture {
+	std::array<std::uint32_t, 256> compute_crc_table();
+	std::uint32_t crc(std::uint32_t crc, unsigned char const* data, std::size_t size);
+	void append_big_endian(std::vector<unsigned char>& out, std::uint32_t value);
+	void write_chunk(std::ofstream& ofs, char const* type, std::vector<unsigned char> const& data);
+	std::vector<unsigned char> zlib_stored(std::vector<unsigned char> const& data);
+
+	std::array<std::uint32_t, 256> const crc_table = compute_crc_table();
+}
+
+std::vector<unsigned char> frame_capture::read_default_framebuffer(std::size_t width, std::size_t height) {
+	std::size_t const stride = 4u * width;
+	std::vector<unsigned char> pixels(stride * height);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	/* OpenGL returns the bottom row first */
+	for(auto row = 0u; row < height / 2u; row++) {
+		auto const top = std::begin(pixels) + row * stride;
+		auto const bottom = std::begin(pixels) + (height - 1u - row) * stride;
+		std::swap_ranges(top, top + stride, bottom);
+	}
+
+	return pixels;
+}
+
+bool frame_capture::write_png(std::filesystem::path const& path, unsigned char const* rgba, std::size_t width, std::size_t height) {
+	std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+	if(!ofs) {
+		ERR_LOG_WARN("Could not open ", path.string(), " for writing");
+		return false;
+	}
+
+	unsigned char const signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	ofs.write(reinterpret_cast<char const*>(signature), sizeof(signature));
+
+	std::vector<unsigned char> header;
+	append_big_endian(header, static_cast<std::uint32_t>(width));
+	append_big_endian(header, static_cast<std::uint32_t>(height));
+	header.insert(std::end(header), {
+		8u, /* Bit depth */
+		6u, /* RGBA */
+		0u, /* Deflate */
+		0u, /* Adaptive filtering */
+		0u  /* Not interlaced */
+	});
+	write_chunk(ofs, "IHDR", header);
+
+	/* Every row is preceded by its filter type, 0 for none */
+	std::size_t const stride = 4u * width;
+	std::vector<unsigned char> scanlines;
+	scanlines.reserve((stride + 1u) * height);
+	for(auto row = 0u; row < height; row++) {
+		scanlines.push_back(0u);
+		scanlines.insert(std::end(scanlines), rgba + row * stride, rgba + (row + 1u) * stride);
+	}
+
+	write_chunk(ofs, "IDAT", zlib_stored(scanlines));
+	write_chunk(ofs, "IEND", {});
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write ", path.string());
+		return false;
+	}
+
+	return true;
+}
+
+bool frame_capture::write_timings(std::filesystem::path const& path, std::vector<double> const& milliseconds) {
+	std::ofstream ofs{path, std::ios::trunc};
+	ofs << "frame,milliseconds\n" << std::fixed << std::setprecision(4);
+	for(auto i = 0u; i < milliseconds.size(); i++)
+		ofs << i << ',' << milliseconds[i] << '\n';
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write frame timings to ", path.string());
+		return false;
+	}
+
+	return true;
+}
+
+std::array<std::uint32_t, 256> frame_capture::compute_crc_table() {
+	std::array<std::uint32_t, 256> table;
+	for(auto i = 0u; i < table.size(); i++) {
+		std::uint32_t value = i;
+		for(auto bit = 0; bit < 8; bit++)
+			value = value & 1u ? 0xedb88320u ^ (value >> 1u) : value >> 1u;
+		table[i] = value;
+	}
+	return table;
+}
+
+std::uint32_t frame_capture::crc(std::uint32_t crc, unsigned char const* data, std::size_t size) {
+	for(auto i = 0u; i < size; i++)
+		crc = crc_table[(crc ^ data[i]) & 0xffu] ^ (crc >> 8u);
+	return crc;
+}
+
+void frame_capture::append_big_endian(std::vector<unsigned char>& out, std::uint32_t value) {
+	for(auto shift : {24u, 16u, 8u, 0u})
+		out.push_back(static_cast<unsigned char>(value >> shift));
+}
+
+void frame_capture::write_chunk(std::ofstream& ofs, char const* type, std::vector<unsigned char> const& data) {
+	std::vector<unsigned char> chunk;
+	chunk.reserve(data.size() + 12u);
+	append_big_endian(chunk, static_cast<std::uint32_t>(data.size()));
+	chunk.insert(std::end(chunk), type, type + 4);
+	chunk.insert(std::end(chunk), std::begin(data), std::end(data));
+
+	/* The checksum covers the type and the data */
+	append_big_endian(chunk, crc(0xffffffffu, chunk.data() + 4u, data.size() + 4u) ^ 0xffffffffu);
+
+	ofs.write(reinterpret_cast<char const*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+}
+
+std::vector<unsigned char> frame_capture::zlib_stored(std::vector<unsigned char> const& data) {
+	std::size_t constexpr MAX_BLOCK = 65'535u;
+
+	std::vector<unsigned char> out{ 0x78, 0x01 };
+	out.reserve(data.size() + (data.size() / MAX_BLOCK + 1u) * 5u + 6u);
+
+	std::size_t offset = 0u;
+	do {
+		std::size_t const size = std::min(MAX_BLOCK, data.size() - offset);
+		bool const last = offset + size == data.size();
+
+		/* Uncompressed deflate block, lengths are little endian */
+		out.push_back(last ? 1u : 0u);
+		out.push_back(static_cast<unsigned char>(size));
+		out.push_back(static_cast<unsigned char>(size >> 8u));
+		out.push_back(static_cast<unsigned char>(~size));
+		out.push_back(static_cast<unsigned char>(~size >> 8u));
+		out.insert(std::end(out), std::begin(data) + offset, std::begin(data) + offset + size);
+
+		offset += size;
+	} while(offset < data.size());
+
+	/* Adler-32 of the uncompressed data */
+	std::uint32_t a = 1u, b = 0u;
+	for(auto byte : data) {
+		a = (a + byte) % 65'521u;
+		b = (b + a) % 65'521u;
+	}
+	append_big_endian(out, (b << 16u) | a);
+
+	return out;
+}
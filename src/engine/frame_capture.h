@@ -0,0 +1,22 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace frame_capture {
+	/* Contents of the default framebuffer of the current context as tightly packed 8-bit RGBA, top row first.
+	 * Should be called after the frame has been composited and before the buffers are swapped */
+	std::vector<unsigned char> read_default_framebuffer(std::size_t width, std::size_t height);
+
+	/* Writes tightly packed 8-bit RGBA pixels, top row first, as a PNG. The image data is stored
+	 * uncompressed, which is fast to write but large. Returns false on failure */
+	bool write_png(std::filesystem::path const& path, unsigned char const* rgba, std::size_t width, std::size_t height);
+
+	/* Writes one line per frame holding its index and duration in milliseconds. Returns false on failure */
+	bool write_timings(std::filesystem::path const& path, std::vector<double> const& milliseconds);
+}
+
+#endif
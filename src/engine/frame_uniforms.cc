@@ -0,0 +1,57 @@
+#include "frame_uniforms.h"
+#include "logger.h"
+
+namespace frame_uniforms {
+	Data data_{};
+	bool dirty{true};
+	GLuint buffer{0u};
+}
+
+void frame_uniforms::set_projection(glm::mat4 const& projection) noexcept {
+	data_.projection = projection;
+	dirty = true;
+}
+
+void frame_uniforms::set_view(glm::mat4 const& view, glm::vec3 camera_position) noexcept {
+	data_.view = view;
+	data_.camera_position = glm::vec4{camera_position, 1.f};
+	dirty = true;
+}
+
+void frame_uniforms::set_clipping_plane(glm::vec4 const& plane) noexcept {
+	data_.clipping_plane = plane;
+	dirty = true;
+}
+
+void frame_uniforms::set_sun_position(glm::vec3 position) noexcept {
+	data_.sun_position = glm::vec4{position, 1.f};
+	dirty = true;
+}
+
+void frame_uniforms::set_time(float time) noexcept {
+	data_.time = time;
+	dirty = true;
+}
+
+frame_uniforms::Data const& frame_uniforms::data() noexcept {
+	return data_;
+}
+
+void frame_uniforms::flush() {
+	if(!buffer) {
+		LOG("Creating frame uniform buffer at binding ", BINDING);
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, buffer);
+		dirty = true;
+	}
+
+	if(!dirty)
+		return;
+
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data_);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	dirty = false;
+}
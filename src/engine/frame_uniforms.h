@@ -0,0 +1,44 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#pragma once
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/* Data shared by every shader that changes at most a few times per frame, held in a single uniform
+ * buffer bound to BINDING. The setters only update a copy in memory, flush writes the copy to the buffer
+ * with a single call, and should be called before drawing whenever the data may have changed.
+ *
+ * Shaders read the data through the FrameUniforms block in assets/shaders/frame_uniforms.glsl,
+ * which is laid out according to std140 and must match Data */
+namespace frame_uniforms {
+	GLuint constexpr BINDING = 0u;
+
+	struct Data {
+		glm::mat4 projection{1.f};
+		glm::mat4 view{1.f};
+		glm::vec4 camera_position{0.f};	/* w is unused */
+		glm::vec4 clipping_plane{0.f};
+		glm::vec4 sun_position{0.f};	/* w is unused */
+		GLfloat time{0.f};
+		GLfloat padding[3]{};			/* std140 rounds the block up to a multiple of 16 bytes */
+	};
+
+	static_assert(offsetof(Data, camera_position) == 128u && offsetof(Data, time) == 176u && sizeof(Data) == 192u,
+				  "Data does not match the std140 layout of FrameUniforms");
+
+	void set_projection(glm::mat4 const& projection) noexcept;
+	void set_view(glm::mat4 const& view, glm::vec3 camera_position) noexcept;
+	void set_clipping_plane(glm::vec4 const& plane) noexcept;
+	void set_sun_position(glm::vec3 position) noexcept;
+	void set_time(float time) noexcept;
+
+	Data const& data() noexcept;
+
+	/* Writes the data to the buffer if it has changed since the last flush. The buffer is created and
+	 * bound on first use, requires a current context */
+	void flush();
+}
+
+#endif
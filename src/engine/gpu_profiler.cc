@@ -0,0 +1,206 @@
+#include "gpu_profiler.h"
+#include "logger.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <GL/glew.h>
+#include <iomanip>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+
+namespace gpu_profiler {
+	struct Pass {
+		std::string name{};
+		std::array<GLuint, FRAMES_IN_FLIGHT> queries{};
+		std::array<bool, FRAMES_IN_FLIGHT> pending{};
+		/* Ring buffer of the latest ROLLING_FRAMES results, in milliseconds */
+		std::vector<double> samples{};
+		std::size_t next_sample{0u};
+		double last{0.0};
+		double run_total{0.0};
+		std::size_t run_samples{0u};
+	};
+
+	bool enabled_{false};
+	std::size_t frame{0u};
+	std::size_t dropped{0u};
+	std::optional<std::size_t> active{};
+
+	std::vector<Pass> passes{};
+	std::unordered_map<std::string, std::size_t> pass_indices{};
+
+	Pass& find_or_add(std::string const& name);
+	void record(Pass& pass, double milliseconds);
+}
+
+void gpu_profiler::set_enabled(bool enabled) {
+	if(!enabled && active)
+		end();
+	enabled_ = enabled;
+}
+
+bool gpu_profiler::enabled() noexcept {
+	return enabled_;
+}
+
+bool gpu_profiler::begin(std::string const& pass) {
+	if(!enabled_)
+		return false;
+
+	if(active) {
+		LOG_WARN("Pass ", pass, " started while ", passes[*active].name, " is still active, ignoring it");
+		return false;
+	}
+
+	auto& p = find_or_add(pass);
+	auto const slot = frame % FRAMES_IN_FLIGHT;
+
+	glBeginQuery(GL_TIME_ELAPSED, p.queries[slot]);
+	p.pending[slot] = true;
+	active = static_cast<std::size_t>(&p - passes.data());
+	return true;
+}
+
+void gpu_profiler::end() {
+	if(!active)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	active.reset();
+}
+
+void gpu_profiler::end_frame() {
+	if(!enabled_)
+		return;
+
+	if(active) {
+		LOG_WARN("Pass ", passes[*active].name, " was not ended before the end of the frame");
+		end();
+	}
+
+	/* The queries about to be reused were issued FRAMES_IN_FLIGHT - 1 frames ago */
+	frame++;
+	auto const slot = frame % FRAMES_IN_FLIGHT;
+
+	for(auto& pass : passes) {
+		if(!pass.pending[slot])
+			continue;
+		pass.pending[slot] = false;
+
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(pass.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+		if(!available) {
+			dropped++;
+			continue;
+		}
+
+		GLuint64 elapsed = 0u;
+		glGetQueryObjectui64v(pass.queries[slot], GL_QUERY_RESULT, &elapsed);
+		record(pass, static_cast<double>(elapsed) / 1e6);
+	}
+}
+
+void gpu_profiler::reset() {
+	for(auto& pass : passes) {
+		pass.samples.clear();
+		pass.next_sample = 0u;
+		pass.last = 0.0;
+		pass.run_total = 0.0;
+		pass.run_samples = 0u;
+	}
+	dropped = 0u;
+}
+
+void gpu_profiler::shutdown() {
+	end();
+	for(auto& pass : passes)
+		glDeleteQueries(static_cast<GLsizei>(pass.queries.size()), pass.queries.data());
+
+	passes.clear();
+	pass_indices.clear();
+	frame = 0u;
+	dropped = 0u;
+}
+
+std::vector<gpu_profiler::PassTime> gpu_profiler::pass_times() {
+	std::vector<PassTime> times;
+	times.reserve(passes.size());
+
+	for(auto const& pass : passes) {
+		double const total = std::accumulate(std::begin(pass.samples), std::end(pass.samples), 0.0);
+		double const average = pass.samples.empty() ? 0.0 : total / static_cast<double>(pass.samples.size());
+		double const run_average = pass.run_samples ? pass.run_total / static_cast<double>(pass.run_samples) : 0.0;
+		times.push_back({pass.name, average, pass.last, pass.samples.size(), run_average, pass.run_samples});
+	}
+
+	return times;
+}
+
+std::size_t gpu_profiler::dropped_results() noexcept {
+	return dropped;
+}
+
+std::string gpu_profiler::summary() {
+	auto const times = pass_times();
+	double const total = std::accumulate(std::begin(times), std::end(times), 0.0, [](double sum, PassTime const& time) {
+		return sum + time.average_ms;
+	});
+
+	std::ostringstream os;
+	os << "GPU time per pass, averaged over the last " << ROLLING_FRAMES << " frames\n" << std::fixed << std::setprecision(3);
+	for(auto const& time : times)
+		os << "  " << std::left << std::setw(20) << time.name << std::right << std::setw(10) << time.average_ms << " ms\n";
+	os << "  " << std::left << std::setw(20) << "total" << std::right << std::setw(10) << total << " ms\n";
+
+	return os.str();
+}
+
+bool gpu_profiler::write(std::filesystem::path const& path) {
+	std::ofstream ofs{path, std::ios::trunc};
+	ofs << "pass,average_ms,last_ms,samples\n" << std::fixed << std::setprecision(4);
+	for(auto const& time : pass_times())
+		ofs << time.name << ',' << time.average_ms << ',' << time.last_ms << ',' << time.samples << '\n';
+
+	if(!ofs) {
+		ERR_LOG_WARN("Could not write GPU pass times to ", path.string());
+		return false;
+	}
+
+	return true;
+}
+
+gpu_profiler::Zone::Zone(std::string const& pass) : started_{begin(pass)} { }
+
+gpu_profiler::Zone::~Zone() {
+	if(started_)
+		end();
+}
+
+gpu_profiler::Pass& gpu_profiler::find_or_add(std::string const& name) {
+	if(auto it = pass_indices.find(name); it != std::end(pass_indices))
+		return passes[it->second];
+
+	LOG("Profiling GPU pass ", name);
+	pass_indices.emplace(name, passes.size());
+	auto& pass = passes.emplace_back();
+	pass.name = name;
+	pass.samples.reserve(ROLLING_FRAMES);
+	glGenQueries(static_cast<GLsizei>(pass.queries.size()), pass.queries.data());
+
+	return pass;
+}
+
+void gpu_profiler::record(Pass& pass, double milliseconds) {
+	pass.last = milliseconds;
+	pass.run_total += milliseconds;
+	pass.run_samples++;
+
+	if(pass.samples.size() < ROLLING_FRAMES)
+		pass.samples.push_back(milliseconds);
+	else
+		pass.samples[pass.next_sample] = milliseconds;
+
+	pass.next_sample = (pass.next_sample + 1u) % ROLLING_FRAMES;
+}
@@ -0,0 +1,72 @@
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/* GPU time spent in named passes, measured using GL_TIME_ELAPSED queries. Every pass owns one query per
+ * frame in flight. The queries of a frame are read back FRAMES_IN_FLIGHT - 1 frames later, and only if
+ * their results are available, so the profiler never waits for the GPU. Results that are not yet
+ * available when their queries are reused are dropped.
+ *
+ * Timer queries cannot be nested, passes must therefore not overlap. Each pass should be measured at
+ * most once per frame. Must only be used on the render thread. Disabled by default, in which case
+ * begin, end and end_frame do nothing */
+namespace gpu_profiler {
+	std::size_t constexpr FRAMES_IN_FLIGHT = 2u;
+	/* Number of frames averaged over */
+	std::size_t constexpr ROLLING_FRAMES = 120u;
+
+	struct PassTime {
+		std::string name;
+		/* Over the last ROLLING_FRAMES frames */
+		double average_ms;
+		double last_ms;
+		std::size_t samples;
+		/* Over every frame since profiling started, or since the last reset */
+		double run_average_ms;
+		std::size_t run_samples;
+	};
+
+	void set_enabled(bool enabled);
+	bool enabled() noexcept;
+
+	/* Returns whether the pass was started, i.e. if the profiler is enabled and no other pass is active */
+	bool begin(std::string const& pass);
+	void end();
+
+	/* Should be called once per frame, after the frame's last pass has ended */
+	void end_frame();
+	/* Discards every result recorded so far, e.g. after warming up */
+	void reset();
+	/* Deletes the queries of every pass and forgets the passes along with their results. Must be called
+	 * while the context is still current, after the results have been read */
+	void shutdown();
+
+	/* In the order the passes were first measured */
+	std::vector<PassTime> pass_times();
+	std::size_t dropped_results() noexcept;
+
+	/* One line per pass */
+	std::string summary();
+	/* Returns false on failure */
+	bool write(std::filesystem::path const& path);
+
+	/* Measures the pass from construction until destruction */
+	class Zone {
+		public:
+			explicit Zone(std::string const& pass);
+			~Zone();
+
+			Zone(Zone const&) = delete;
+			Zone& operator=(Zone const&) = delete;
+
+		private:
+			bool const started_;
+	};
+}
+
+#endif
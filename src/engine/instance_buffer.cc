@@ -0,0 +1,114 @@
+#include "instance_buffer.h"
+#include "exception.h"
+#include "logger.h"
+#include <algorithm>
+
+InstanceBuffer::InstanceBuffer() {
+	glGenBuffers(1, &buffer_);
+}
+
+InstanceBuffer::~InstanceBuffer() {
+	glDeleteBuffers(1, &buffer_);
+}
+
+InstanceBuffer::handle_t InstanceBuffer::add(glm::mat4 const& model) {
+	handle_t handle;
+	if(free_.empty()) {
+		handle = slots_.size();
+		slots_.push_back(INVALID);
+	}
+	else {
+		handle = free_.back();
+		free_.pop_back();
+	}
+
+	slots_[handle] = models_.size();
+	models_.push_back(model);
+	handles_.push_back(handle);
+	mark_dirty(models_.size() - 1u);
+
+	return handle;
+}
+
+void InstanceBuffer::update(handle_t handle, glm::mat4 const& model) {
+	if(handle >= slots_.size() || slots_[handle] == INVALID)
+		throw InvalidArgumentException{"Invalid instance handle"};
+
+	models_[slots_[handle]] = model;
+	mark_dirty(slots_[handle]);
+}
+
+void InstanceBuffer::remove(handle_t handle) {
+	if(handle >= slots_.size() || slots_[handle] == INVALID)
+		throw InvalidArgumentException{"Invalid instance handle"};
+
+	std::size_t const slot = slots_[handle];
+	std::size_t const last = models_.size() - 1u;
+
+	if(slot != last) {
+		models_[slot] = models_[last];
+		handles_[slot] = handles_[last];
+		slots_[handles_[slot]] = slot;
+		mark_dirty(slot);
+	}
+
+	models_.pop_back();
+	handles_.pop_back();
+	slots_[handle] = INVALID;
+	free_.push_back(handle);
+}
+
+void InstanceBuffer::clear() noexcept {
+	models_.clear();
+	handles_.clear();
+	slots_.clear();
+	free_.clear();
+	dirty_begin_ = INVALID;
+	dirty_end_ = 0u;
+}
+
+std::size_t InstanceBuffer::size() const noexcept {
+	return models_.size();
+}
+
+void InstanceBuffer::bind() const {
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+	upload();
+
+	for(GLuint column = 0u; column < 4u; column++) {
+		glEnableVertexAttribArray(LOCATION + column);
+		glVertexAttribPointer(LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(column * sizeof(glm::vec4)));
+		glVertexAttribDivisor(LOCATION + column, 1u);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::unbind() const {
+	for(GLuint column = 0u; column < 4u; column++)
+		glDisableVertexAttribArray(LOCATION + column);
+}
+
+void InstanceBuffer::mark_dirty(std::size_t slot) noexcept {
+	dirty_begin_ = std::min(dirty_begin_, slot);
+	dirty_end_ = std::max(dirty_end_, slot + 1u);
+}
+
+void InstanceBuffer::upload() const {
+	if(models_.size() > capacity_) {
+		/* Grow geometrically, so that adding instances one at a time reallocates rarely */
+		capacity_ = std::max(models_.size(), 2u * capacity_);
+		LOG("Reallocating instance buffer ", buffer_, " for ", capacity_, " instances");
+
+		glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * capacity_, nullptr, GL_DYNAMIC_DRAW);
+		dirty_begin_ = 0u;
+		dirty_end_ = models_.size();
+	}
+
+	dirty_end_ = std::min(dirty_end_, models_.size());
+	if(dirty_begin_ < dirty_end_)
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * dirty_begin_, sizeof(glm::mat4) * (dirty_end_ - dirty_begin_), &models_[dirty_begin_]);
+
+	dirty_begin_ = INVALID;
+	dirty_end_ = 0u;
+}
@@ -0,0 +1,57 @@
+#ifndef INSTANCE_BUFFER_H
+#define INSTANCE_BUFFER_H
+
+#pragma once
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+/* Model matrices of the instances of a mesh drawn with Renderer::render(InstanceBuffer const&), read by the
+ * vertex shader as a per-instance mat4 attribute at LOCATION through LOCATION + 3, see
+ * assets/shaders/instanced.vert.
+ *
+ * Instances are identified by handles that stay valid until the instance is removed. The matrices are
+ * kept densely packed, removing an instance moves the last one into its place, and only the range
+ * changed since the last draw is uploaded. Instances are not culled individually */
+class InstanceBuffer {
+	public:
+		using handle_t = std::size_t;
+
+		static GLuint constexpr LOCATION = 4u;
+
+		InstanceBuffer();
+		~InstanceBuffer();
+
+		InstanceBuffer(InstanceBuffer const&) = delete;
+		InstanceBuffer& operator=(InstanceBuffer const&) = delete;
+
+		handle_t add(glm::mat4 const& model);
+		void update(handle_t handle, glm::mat4 const& model);
+		void remove(handle_t handle);
+		void clear() noexcept;
+
+		std::size_t size() const noexcept;
+
+		/* Uploads pending changes and points the instance attributes of the bound vertex array at the buffer */
+		void bind() const;
+		void unbind() const;
+
+	private:
+		static std::size_t constexpr INVALID = ~std::size_t{0u};
+
+		std::vector<glm::mat4> models_{};
+		std::vector<handle_t> handles_{};	/* Handle of every slot in models_ */
+		std::vector<std::size_t> slots_{};	/* Slot of every handle, INVALID if removed */
+		std::vector<handle_t> free_{};		/* Removed handles, reused by add */
+
+		GLuint buffer_{0u};
+		std::size_t mutable capacity_{0u};
+		std::size_t mutable dirty_begin_{INVALID};
+		std::size_t mutable dirty_end_{0u};
+
+		void mark_dirty(std::size_t slot) noexcept;
+		void upload() const;
+};
+
+#endif
@@ -25,6 +25,7 @@
 #else
 
 #pragma once
+#include "cpu_profiler.h"
 #include "exception.h"
 #include "traits.h"
 #include <algorithm>
@@ -56,6 +56,7 @@ void logging::FileLogger<T, enable_on_match_t<T, logging::FileLoggingTag>>::init
 template <typename T>
 void logging::FileLogger<T, enable_on_match_t<T, logging::FileLoggingTag>>::monitor_log_file() {
 	using namespace std::chrono_literals;
+	PROFILE_THREAD("log_compressor");
 	std::this_thread::sleep_for(60s);
 
 	while(should_compress_) {
@@ -75,6 +76,7 @@ void logging::FileLogger<T, enable_on_match_t<T, logging::FileLoggingTag>>::moni
 
 template <typename T>
 void logging::FileLogger<T, enable_on_match_t<T, logging::FileLoggingTag>>::compress_content() {
+	PROFILE_ZONE("compress_log");
 	LOG("Compressing log file");
 	ofs_.close();
 	std::ifstream ifs{log_file_};
@@ -2,11 +2,19 @@
 #define RENDERER_H
 
 #pragma once
+#include "aabb.h"
+#include "buffer_policy.h"
 #include "exception.h"
+#include "frustum.h"
+#include "instance_buffer.h"
 #include "render_constraints.h"
+#include "ring_buffer.h"
 #include "shader_handler.h"
 #include "traits.h"
 #include "transform.h"
+#include "vertex_layout.h"
+#include <algorithm>
+#include <cstring>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <iostream>
@@ -14,6 +22,7 @@
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 /* Inheriting (through CRTP) from Renderer will enable rendering (through the render() member function) for any type that fulfills the rendering criteria.
  * For a class T, the criteria are as follows:
@@ -22,7 +31,7 @@
  *		- If a dynamic c-style array is returned by vertices(), T must also name a public function vertices_size() that returns the size of 
  *		  the array returned by vertices() (an integral value).
  * 	  
- * 2. T must name a public function indices() that returns a container that's, again, stored contiguously but wraps an integral type.
+ * 2. T must name a public function indices() that returns a container that's, again, stored contiguously but wraps GLuint, GLushort or GLubyte.
  *    Cv and ref modifiers for the container are accepted, pointers to stl containers are not. Returning c-style dynamic arrays is valid.
  *      - If a dynamic c-style array is returned by indices(), T must also name a public function indices_size() that returns the size of the 
  *        array returned by indices() (integral value).
@@ -35,19 +44,35 @@
  *    	- An exception to this rule is if all members of T (including vertices and indices containers) are static.
  *    	
  *
- * Any attempt to inherit from Renderer with a class that does not fulfill these requirements will trigger a static assert in the Renderer contructor */
+ * Any attempt to inherit from Renderer with a class that does not fulfill these requirements will trigger a static assert in the Renderer contructor
+ *
+ * The vertices are laid out according to T::vertex_layout if T names one, and float_vertex_layout otherwise, see
+ * vertex_layout.h. The bounding box is computed once in init, from the first three values of every vertex
+ * unless T names a public function bounds() returning an AABB. Objects that are transformable are culled against Frustum::active(),
+ * skipping setup, uniform uploads and the draw call entirely. Objects that are not transformable are never culled
+ *
+ * The BufferPolicy decides how the vertices are stored, see buffer_policy.h. With dynamic_buffer, T may
+ * call update_vertices whenever the container returned by vertices() has changed
+ *
+ * render(InstanceBuffer const&) draws the mesh once for every instance in the buffer with a single
+ * glDrawElementsInstanced. The model matrices are taken from the instances, so the model matrix of the
+ * object itself is neither uploaded nor used for culling
+ *
+ * GLuint indices are uploaded as GLushort if there are at most 65535 vertices. Their order is left as is, T may
+ * reorder them for the vertex cache through vertex_cache::optimize */
 
 struct vertices_tag { };
 struct indices_tag { };
 
 
-template <typename T, typename ShaderPolicy = manual_shader_handler>
+template <typename T, typename ShaderPolicy = manual_shader_handler, typename BufferPolicy = static_buffer>
 class Renderer {
 	public:
 		~Renderer();
 		void render() const;
+		void render(InstanceBuffer const& instances) const;
 	
-		static GLuint constexpr VERTEX_SIZE = 8u;
+		static GLuint constexpr VERTEX_SIZE = float_vertex_layout::SIZE; /* Of the default layout */
 	protected:
 		Renderer(ShaderPolicy policy = {});
         void bind() const;
@@ -57,16 +82,27 @@ class Renderer {
 		template <typename... Args>
 		void init(Args&&... args);
 
+		/* Writes the vertices to the next region of the ring buffer, requires dynamic_buffer */
+		void update_vertices();
+
 		template <typename U = ShaderPolicy> 
 		static auto constexpr policy_is_automatic(int) noexcept -> std::remove_reference_t<decltype((void)U::is_automatic, std::declval<bool>())>;
 		static bool constexpr policy_is_automatic(long) noexcept;
 
+		template <typename U = BufferPolicy>
+		static auto constexpr policy_is_dynamic(int) noexcept -> std::remove_reference_t<decltype((void)U::is_dynamic, std::declval<bool>())>;
+		static bool constexpr policy_is_dynamic(long) noexcept;
+
         static int constexpr OVERLOAD_RESOLVER = 0;
 	private:
 		GLuint vao_, vbo_;
 		GLuint idx_buffer_;
 		GLuint idx_size_;
+		GLenum idx_type_;	/* GL_UNSIGNED_SHORT whenever the vertices can be indexed with 16 bits */
+		AABB bounds_;
 		ShaderPolicy const policy_;
+		Shader::Uniform<glm::mat4> model_uniform_{};
+		std::unique_ptr<RingBuffer> ring_{};	/* Only with dynamic_buffer */
 
 		/* Tag dispatch */
 		GLuint size(vertices_tag) const;
@@ -85,6 +121,12 @@ class Renderer {
 		static auto constexpr object_is_transformable(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().has_been_transformed(), std::declval<bool>())>;
 		static bool constexpr object_is_transformable(long) noexcept;
 
+		template <typename U = T>
+		static auto constexpr provides_bounds(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().bounds(), std::declval<bool>())>;
+		static bool constexpr provides_bounds(long) noexcept;
+
+		AABB compute_bounds() const;
+		bool is_culled() const noexcept;
 		bool& object_has_been_transformed() const noexcept;
 		glm::mat4 get_model_matrix() const noexcept;
 };
@@ -1,22 +1,28 @@
-template <typename T, typename ShaderPolicy>
-Renderer<T, ShaderPolicy>::Renderer(ShaderPolicy policy) : vao_{0u}, vbo_{0u}, idx_buffer_{0u}, idx_size_{0u}, policy_{policy}  {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+Renderer<T, ShaderPolicy, BufferPolicy>::Renderer(ShaderPolicy policy) : vao_{0u}, vbo_{0u}, idx_buffer_{0u}, idx_size_{0u}, idx_type_{GL_UNSIGNED_INT}, bounds_{}, policy_{policy}  {
 	static_assert(is_renderable_v<T>, "Type does not fulfill the rendering requirements");
+
+	if constexpr(policy_is_automatic(OVERLOAD_RESOLVER))
+		model_uniform_ = policy_.shader()->template uniform<glm::mat4>(Shader::MODEL_UNIFORM_NAME);
 }
 
-template <typename T, typename ShaderPolicy>
-Renderer<T, ShaderPolicy>::~Renderer() {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+Renderer<T, ShaderPolicy, BufferPolicy>::~Renderer() {
 	glDeleteVertexArrays(1, &vao_);
 	glDeleteBuffers(1, &vbo_);
 }
 
-template <typename T, typename ShaderPolicy>
-void Renderer<T, ShaderPolicy>::render() const {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::render() const {
+	if(is_culled())
+		return;
+
 	if constexpr(requires_setup(OVERLOAD_RESOLVER))
 		static_cast<T const&>(*this).render_setup();
 
 	if constexpr(object_is_transformable(OVERLOAD_RESOLVER)) {
 		if(object_has_been_transformed()) {
-			policy_.shader()->template upload_uniform<true>(Shader::MODEL_UNIFORM_NAME, get_model_matrix());
+			policy_.shader()->template upload_uniform<true>(model_uniform_, get_model_matrix());
 			object_has_been_transformed() = false;
 		}
 	}
@@ -27,30 +33,62 @@ void Renderer<T, ShaderPolicy>::render() const {
     bind();
     draw();
     unbind();
+
+	if constexpr(policy_is_dynamic(OVERLOAD_RESOLVER))
+		ring_->fence();
 	
 	if constexpr(requires_cleanup(OVERLOAD_RESOLVER)) 
 		static_cast<T const&>(*this).render_cleanup();
 }
 
-template <typename T, typename ShaderPolicy>
-void Renderer<T, ShaderPolicy>::bind() const {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::render(InstanceBuffer const& instances) const {
+	if(!instances.size())
+		return;
+
+	if constexpr(requires_setup(OVERLOAD_RESOLVER))
+		static_cast<T const&>(*this).render_setup();
+
+	if constexpr(policy_is_automatic(OVERLOAD_RESOLVER))
+		policy_();
+
+	bind();
+	instances.bind();
+	glDrawElementsInstanced(GL_TRIANGLES, idx_size_, idx_type_, static_cast<void*>(0), static_cast<GLsizei>(instances.size()));
+	instances.unbind();
+	unbind();
+
+	if constexpr(policy_is_dynamic(OVERLOAD_RESOLVER))
+		ring_->fence();
+
+	if constexpr(requires_cleanup(OVERLOAD_RESOLVER)) 
+		static_cast<T const&>(*this).render_cleanup();
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::bind() const {
 	glBindVertexArray(vao_);
+
+	if constexpr(policy_is_dynamic(OVERLOAD_RESOLVER)) {
+		using layout_t = vertex_layout_of_t<T>;
+		glBindVertexBuffer(0, ring_->id(), ring_->offset(), layout_t::SIZE * sizeof(typename layout_t::value_type));
+	}
 }   
 
-template <typename T, typename ShaderPolicy>
-void Renderer<T, ShaderPolicy>::draw() const {
-	glDrawElements(GL_TRIANGLES, idx_size_, GL_UNSIGNED_INT, static_cast<void*>(0));
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::draw() const {
+	glDrawElements(GL_TRIANGLES, idx_size_, idx_type_, static_cast<void*>(0));
 }
 
-template <typename T, typename ShaderPolicy>
-void Renderer<T, ShaderPolicy>::unbind() const {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::unbind() const {
 	glBindVertexArray(0);
 }
 
 
-template <typename T, typename ShaderPolicy>
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
 template <typename... Args>
-void Renderer<T, ShaderPolicy>::init(Args&&... args) {
+void Renderer<T, ShaderPolicy, BufferPolicy>::init(Args&&... args) {
 	if constexpr(has_arbitrary_init_v<T>)
 		static_cast<T&>(*this).init(std::forward<Args>(args)...); /* Initialize T */
 
@@ -58,13 +96,12 @@ void Renderer<T, ShaderPolicy>::init(Args&&... args) {
 	glGenVertexArrays(1, &vao_);
 	glBindVertexArray(vao_);
 
-	/* vbo */
-	glGenBuffers(1, &vbo_);
-	glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-
 	{
+		using layout_t = vertex_layout_of_t<T>;
+
 		auto const& vertices = static_cast<T&>(*this).vertices(); /* Ref to vertices */
-		using value_type = fundamental_type_t<decltype(vertices)>;
+		using value_type = std::remove_cv_t<fundamental_type_t<decltype(vertices)>>;
+		static_assert(std::is_same_v<value_type, typename layout_t::value_type>, "Vertices do not match the vertex layout of T");
 
 		auto const VALUE_TYPE_SIZE  = sizeof(value_type);
 
@@ -72,25 +109,35 @@ void Renderer<T, ShaderPolicy>::init(Args&&... args) {
 	
 		GLuint const TOTAL_SIZE = VALUE_TYPE_SIZE * NUMBER_OF_VERTICES;
 
-		/* Upload to gpu */
-		glBufferData(GL_ARRAY_BUFFER, TOTAL_SIZE, &vertices[0], GL_STATIC_DRAW);
-
-		glEnableVertexAttribArray(0); /* Position */
-		glEnableVertexAttribArray(1); /* Normal */
-		glEnableVertexAttribArray(2); /* Texture */
+		if constexpr(policy_is_dynamic(OVERLOAD_RESOLVER)) {
+			/* The buffer is bound with the offset of the current region in bind */
+			ring_ = std::make_unique<RingBuffer>(GL_ARRAY_BUFFER, TOTAL_SIZE);
+			std::memcpy(ring_->next(), &vertices[0], TOTAL_SIZE);
+		}
+		else {
+			/* vbo */
+			glGenBuffers(1, &vbo_);
+			glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+
+			/* Upload to gpu */
+			glBufferData(GL_ARRAY_BUFFER, TOTAL_SIZE, &vertices[0], GL_STATIC_DRAW);
+			glBindVertexBuffer(0, vbo_, 0, layout_t::SIZE * VALUE_TYPE_SIZE);
+		}
 
-		/* Offsets in data */
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)0);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)(3 * VALUE_TYPE_SIZE));
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * VALUE_TYPE_SIZE, (void*)(6 * VALUE_TYPE_SIZE));
+		bounds_ = compute_bounds();
+		layout_t::specify_attributes();
 	}
 	{
 		auto const& indices = static_cast<T&>(*this).indices(); /* Ref to indices */
 		
-		using value_type = fundamental_type_t<decltype(indices)>;
+		using value_type = std::remove_cv_t<fundamental_type_t<decltype(indices)>>;
+		static_assert(std::is_same_v<value_type, GLuint> || std::is_same_v<value_type, GLushort> || std::is_same_v<value_type, GLubyte>,
+					  "Indices must be GLuint, GLushort or GLubyte");
+
 		auto const VALUE_TYPE_SIZE = sizeof(value_type);
 	
 		idx_size_ = size(indices_tag{});
+		GLuint const NUMBER_OF_VERTICES = size(vertices_tag{}) / vertex_layout_of_t<T>::SIZE;
 	
 		GLuint const TOTAL_SIZE = VALUE_TYPE_SIZE * idx_size_;
 
@@ -98,7 +145,25 @@ void Renderer<T, ShaderPolicy>::init(Args&&... args) {
 		glGenBuffers(1, &idx_buffer_);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_);
 
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, TOTAL_SIZE, &indices[0], GL_STATIC_DRAW);
+		/* Halves the index bandwidth if every index fits in 16 bits */
+		if(std::is_same_v<value_type, GLuint> && NUMBER_OF_VERTICES <= std::numeric_limits<GLushort>::max()) {
+			std::vector<GLushort> narrowed(idx_size_);
+			std::transform(&indices[0], &indices[0] + idx_size_, std::begin(narrowed), [](value_type idx) {
+				return static_cast<GLushort>(idx);
+			});
+
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * idx_size_, narrowed.data(), GL_STATIC_DRAW);
+			idx_type_ = GL_UNSIGNED_SHORT;
+		}
+		else {
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, TOTAL_SIZE, &indices[0], GL_STATIC_DRAW);
+			if constexpr(std::is_same_v<value_type, GLuint>)
+				idx_type_ = GL_UNSIGNED_INT;
+			else if constexpr(std::is_same_v<value_type, GLushort>)
+				idx_type_ = GL_UNSIGNED_SHORT;
+			else
+				idx_type_ = GL_UNSIGNED_BYTE;
+		}
 	}
 	
 	/* Unbind */
@@ -107,8 +172,23 @@ void Renderer<T, ShaderPolicy>::init(Args&&... args) {
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-template <typename T, typename ShaderPolicy>
-GLuint Renderer<T, ShaderPolicy>::size(vertices_tag) const {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+void Renderer<T, ShaderPolicy, BufferPolicy>::update_vertices() {
+	static_assert(policy_is_dynamic(OVERLOAD_RESOLVER), "Vertices can only be updated if the buffer policy is dynamic_buffer");
+
+	auto const& vertices = static_cast<T&>(*this).vertices();
+	auto const NUMBER_OF_VERTICES = size(vertices_tag{});
+	std::size_t const TOTAL_SIZE = sizeof(typename vertex_layout_of_t<T>::value_type) * NUMBER_OF_VERTICES;
+
+	if(TOTAL_SIZE > ring_->region_size())
+		throw OverflowException{"Updated vertices do not fit in the buffer allocated in init\n"};
+
+	std::memcpy(ring_->next(), &vertices[0], TOTAL_SIZE);
+	bounds_ = compute_bounds();
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+GLuint Renderer<T, ShaderPolicy, BufferPolicy>::size(vertices_tag) const {
 	std::size_t container_size;
 
 	if constexpr(is_contiguously_stored_v<decltype(static_cast<T const&>(*this).vertices())>)
@@ -122,8 +202,8 @@ GLuint Renderer<T, ShaderPolicy>::size(vertices_tag) const {
 	return static_cast<GLuint>(container_size);
 }
 
-template <typename T, typename ShaderPolicy>
-GLuint Renderer<T, ShaderPolicy>::size(indices_tag) const {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+GLuint Renderer<T, ShaderPolicy, BufferPolicy>::size(indices_tag) const {
 	std::size_t container_size;
 
 	if constexpr(is_contiguously_stored_v<decltype(static_cast<T const&>(*this).indices())>)
@@ -137,56 +217,96 @@ GLuint Renderer<T, ShaderPolicy>::size(indices_tag) const {
 	return static_cast<GLuint>(container_size);
 }
 
-template <typename T, typename ShaderPolicy>
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
 template <typename U>
-auto constexpr Renderer<T, ShaderPolicy>::requires_setup(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().render_setup(), std::declval<bool>())> {
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::requires_setup(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().render_setup(), std::declval<bool>())> {
 	return true;
 }
 
-template <typename T, typename ShaderPolicy>
-bool constexpr Renderer<T, ShaderPolicy>::requires_setup(long) noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::requires_setup(long) noexcept {
 	return false;
 }
 
-template <typename T, typename ShaderPolicy>
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
 template <typename U>
-auto constexpr Renderer<T, ShaderPolicy>::requires_cleanup(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().render_cleanup(), std::declval<bool>())> {
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::requires_cleanup(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().render_cleanup(), std::declval<bool>())> {
 	return true;
 }
 
-template <typename T, typename ShaderPolicy>
-bool constexpr Renderer<T, ShaderPolicy>::requires_cleanup(long) noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::requires_cleanup(long) noexcept {
 	return false;
 }
 
-template <typename T, typename ShaderPolicy>
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
 template <typename U>
-auto constexpr Renderer<T, ShaderPolicy>::policy_is_automatic(int) noexcept -> std::remove_reference_t<decltype((void)U::is_automatic, std::declval<bool>())> {
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::policy_is_automatic(int) noexcept -> std::remove_reference_t<decltype((void)U::is_automatic, std::declval<bool>())> {
 	return ShaderPolicy::is_automatic;
 }
 
-template <typename T, typename ShaderPolicy>
-bool constexpr Renderer<T, ShaderPolicy>::policy_is_automatic(long) noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::policy_is_automatic(long) noexcept {
+	return false;
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+template <typename U>
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::policy_is_dynamic(int) noexcept -> std::remove_reference_t<decltype((void)U::is_dynamic, std::declval<bool>())> {
+	return BufferPolicy::is_dynamic;
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::policy_is_dynamic(long) noexcept {
 	return false;
 }
 
-template <typename T, typename ShaderPolicy>
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
 template <typename U>
-auto constexpr Renderer<T, ShaderPolicy>::object_is_transformable(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().has_been_transformed(), std::declval<bool>())> {
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::object_is_transformable(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().has_been_transformed(), std::declval<bool>())> {
 	return true;
 }
 
-template <typename T, typename ShaderPolicy>
-bool constexpr Renderer<T, ShaderPolicy>::object_is_transformable(long) noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::object_is_transformable(long) noexcept {
 	return false;
 }
 
-template <typename T, typename ShaderPolicy>
-bool& Renderer<T, ShaderPolicy>::object_has_been_transformed() const noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+template <typename U>
+auto constexpr Renderer<T, ShaderPolicy, BufferPolicy>::provides_bounds(int) noexcept -> std::remove_reference_t<decltype((void)std::declval<U>().bounds(), std::declval<bool>())> {
+	return true;
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool constexpr Renderer<T, ShaderPolicy, BufferPolicy>::provides_bounds(long) noexcept {
+	return false;
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+AABB Renderer<T, ShaderPolicy, BufferPolicy>::compute_bounds() const {
+	if constexpr(provides_bounds(OVERLOAD_RESOLVER))
+		return static_cast<T const&>(*this).bounds();
+	else {
+		auto const& vertices = static_cast<T const&>(*this).vertices();
+		return AABB::from_vertices(&vertices[0], size(vertices_tag{}), vertex_layout_of_t<T>::SIZE);
+	}
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool Renderer<T, ShaderPolicy, BufferPolicy>::is_culled() const noexcept {
+	if constexpr(object_is_transformable(OVERLOAD_RESOLVER))
+		return !Frustum::active().intersects(bounds_.transformed(get_model_matrix()));
+	else
+		return false;
+}
+
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+bool& Renderer<T, ShaderPolicy, BufferPolicy>::object_has_been_transformed() const noexcept {
 	return static_cast<T const&>(*this).has_been_transformed();
 }
 
-template <typename T, typename ShaderPolicy>
-glm::mat4 Renderer<T, ShaderPolicy>::get_model_matrix() const noexcept {
+template <typename T, typename ShaderPolicy, typename BufferPolicy>
+glm::mat4 Renderer<T, ShaderPolicy, BufferPolicy>::get_model_matrix() const noexcept {
 	return static_cast<T const&>(*this).model_matrix();
 }
@@ -0,0 +1,74 @@
+#include "ring_buffer.h"
+#include "exception.h"
+#include "logger.h"
+
+RingBuffer::RingBuffer(GLenum target, std::size_t region_size) : target_{target}, region_size_{(region_size + ALIGNMENT - 1u) / ALIGNMENT * ALIGNMENT} {
+	if(!region_size)
+		throw InvalidArgumentException{"Ring buffer regions cannot be empty"};
+
+	GLbitfield constexpr flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	auto const size = static_cast<GLsizeiptr>(REGIONS * region_size_);
+
+	glGenBuffers(1, &buffer_);
+	glBindBuffer(target_, buffer_);
+	glBufferStorage(target_, size, nullptr, flags);
+	data_ = static_cast<unsigned char*>(glMapBufferRange(target_, 0, size, flags));
+	glBindBuffer(target_, 0);
+
+	if(!data_) {
+		glDeleteBuffers(1, &buffer_);
+		throw GLException{"Unable to map ring buffer persistently"};
+	}
+
+	LOG("Created ring buffer with id ", buffer_, " of ", REGIONS, " regions of ", region_size_, " bytes");
+}
+
+RingBuffer::~RingBuffer() {
+	for(auto fence : fences_)
+		glDeleteSync(fence);
+
+	glBindBuffer(target_, buffer_);
+	glUnmapBuffer(target_);
+	glBindBuffer(target_, 0);
+	glDeleteBuffers(1, &buffer_);
+}
+
+void* RingBuffer::next() {
+	region_ = (region_ + 1u) % REGIONS;
+
+	if(auto& fence = fences_[region_]) {
+		/* Flushing on the first wait only, so that the fence is guaranteed to be signaled eventually */
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		GLenum status;
+		while((status = glClientWaitSync(fence, flags, WAIT_TIMEOUT_NS)) == GL_TIMEOUT_EXPIRED)
+			flags = 0;
+
+		if(status == GL_WAIT_FAILED) {
+			ERR_LOG_WARN("Waiting for ring buffer region ", region_, " failed");
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	return data_ + region_ * region_size_;
+}
+
+void RingBuffer::fence() {
+	/* Commands complete in order, so the latest fence covers every earlier command reading the region */
+	auto& fence = fences_[region_];
+	glDeleteSync(fence);
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLuint RingBuffer::id() const noexcept {
+	return buffer_;
+}
+
+GLintptr RingBuffer::offset() const noexcept {
+	return static_cast<GLintptr>(region_ * region_size_);
+}
+
+std::size_t RingBuffer::region_size() const noexcept {
+	return region_size_;
+}
@@ -0,0 +1,49 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <GL/glew.h>
+
+/* Buffer of REGIONS equally sized regions, created with glBufferStorage and mapped persistently and
+ * coherently for its entire lifetime. Every update is written to the region following the current one,
+ * while the GPU may still be reading the others, and each region is guarded by a fence placed after the
+ * last command reading from it. Writing only waits if the GPU is more than REGIONS - 1 updates behind.
+ *
+ * Requires a current context, and must be used from the thread owning it */
+class RingBuffer {
+	public:
+		static std::size_t constexpr REGIONS = 3u;
+
+		RingBuffer(GLenum target, std::size_t region_size);
+		~RingBuffer();
+
+		RingBuffer(RingBuffer const&) = delete;
+		RingBuffer& operator=(RingBuffer const&) = delete;
+
+		/* Makes the next region current, waiting until the GPU is done with it, and returns a
+		 * pointer to it. No more than region_size() bytes may be written */
+		void* next();
+
+		/* Should be called after the commands reading from the current region have been issued */
+		void fence();
+
+		GLuint id() const noexcept;
+		GLintptr offset() const noexcept;		/* Of the current region */
+		std::size_t region_size() const noexcept;
+
+	private:
+		GLenum const target_;
+		std::size_t const region_size_;
+		GLuint buffer_{0u};
+		unsigned char* data_{nullptr};
+		std::array<GLsync, REGIONS> fences_{};
+		std::size_t region_{0u};
+
+		/* Offsets of the regions are aligned to this, which covers vertex, uniform and storage buffers */
+		static std::size_t constexpr ALIGNMENT = 256u;
+		static GLuint64 constexpr WAIT_TIMEOUT_NS = 1000000u;
+};
+
+#endif
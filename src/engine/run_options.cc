@@ -0,0 +1,88 @@
+#include "exception.h"
+#include "run_options.h"
+#include <string>
+
+namespace {
+	std::size_t parse_count(std::string const& option, char const* value) {
+		std::size_t parsed = 0u;
+		std::size_t count = 0u;
+		try {
+			count = std::stoul(value, &parsed);
+		}
+		catch(std::exception const&) {
+			parsed = 0u;
+		}
+
+		if(parsed == 0u || value[parsed] != '\0' || value[0] == '-' || count == 0u)
+			throw InvalidArgumentException{"Option " + option + " requires a positive integer, got " + value};
+
+		return count;
+	}
+}
+
+bool RunOptions::should_capture(std::size_t frame) const noexcept {
+	return capture_directory && frame % capture_interval == 0u;
+}
+
+bool RunOptions::is_last_frame(std::size_t frame) const noexcept {
+	return frames && frame + 1u >= frames;
+}
+
+bool RunOptions::reproducible() const noexcept {
+	return headless || benchmark_file || camera_path_file || capture_directory;
+}
+
+RunOptions RunOptions::parse(int argc, char const* const* argv) {
+	RunOptions options;
+	bool frames_given = false;
+
+	for(auto i = 1; i < argc; i++) {
+		std::string const option = argv[i];
+		auto value = [&]() {
+			if(i + 1 >= argc)
+				throw InvalidArgumentException{"Option " + option + " requires a value"};
+			return argv[++i];
+		};
+
+		if(option == "--headless")
+			options.headless = true;
+		else if(option == "--frames") {
+			options.frames = parse_count(option, value());
+			frames_given = true;
+		}
+		else if(option == "--capture")
+			options.capture_directory = value();
+		else if(option == "--capture-interval")
+			options.capture_interval = parse_count(option, value());
+		else if(option == "--timings")
+			options.timings_file = value();
+		else if(option == "--gpu-profile")
+			options.gpu_profile_file = value();
+		else if(option == "--cpu-trace")
+			options.cpu_trace_file = value();
+		else if(option == "--benchmark")
+			options.benchmark_file = value();
+		else if(option == "--camera-path")
+			options.camera_path_file = value();
+		else if(option == "--record-path")
+			options.record_path_file = value();
+		else if(option == "--cdlod")
+			options.cdlod = true;
+		else if(option == "--props")
+			options.props = true;
+		else if(option == "--verify-heightfield")
+			options.verify_heightfield = true;
+		else
+			throw InvalidArgumentException{"Unknown option " + option};
+	}
+
+	if(options.camera_path_file && options.record_path_file)
+		throw InvalidArgumentException{"Options --camera-path and --record-path cannot be combined"};
+
+	if(options.benchmark_file && !frames_given)
+		options.frames = DEFAULT_BENCHMARK_FRAMES;
+	else if(options.headless && !frames_given)
+		options.frames = DEFAULT_HEADLESS_FRAMES;
+
+	return options;
+}
@@ -0,0 +1,61 @@
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+/* Command line options
+ *	--headless					Render without a visible window, see Context. Runs DEFAULT_HEADLESS_FRAMES frames
+ *								unless --frames is given
+ *	--frames N					Exit after N frames
+ *	--capture DIRECTORY			Write the composited frame to DIRECTORY/frame_NNNNN.png
+ *	--capture-interval K		Capture every K-th frame, 1 by default
+ *	--timings FILE				Write the time taken by every frame to FILE
+ *	--gpu-profile FILE			Measure the GPU time of every render pass, see gpu_profiler, and write
+ *								the rolling averages to FILE on exit
+ *	--cpu-trace FILE			Write the zones recorded by cpu_profiler to FILE on exit, and when F9 is
+ *								pressed. Requires PROFILE_CPU
+ *	--benchmark FILE			Replay a camera path with vsync disabled and write frame time statistics and
+ *								per-pass GPU times to FILE. Runs DEFAULT_BENCHMARK_FRAMES frames unless
+ *								--frames is given, of which the first benchmark_report::WARMUP_FRAMES are
+ *								not measured. Orbits the terrain unless --camera-path is given
+ *	--camera-path FILE			Replay the camera path in FILE, see CameraPath
+ *	--record-path FILE			Write the path the camera takes to FILE on exit
+ *	--cdlod						Render the terrain with QuadtreeTerrain rather than ChunkedTerrain
+ *	--props						Scatter rocks over the terrain, drawn as a single DrawBatch, and trees, drawn
+ *								as instances of a single mesh
+ *	--verify-heightfield		Compare the heightfield generated by HeightfieldCompute to its CPU reference
+ *								and exit, with a non-zero code if they differ by more than its tolerance
+ *
+ * Throws InvalidArgumentException on unknown options or invalid values */
+struct RunOptions {
+	bool headless{false};
+	/* 0 runs until the window is closed */
+	std::size_t frames{0u};
+	std::optional<std::filesystem::path> capture_directory{};
+	std::size_t capture_interval{1u};
+	std::optional<std::filesystem::path> timings_file{};
+	std::optional<std::filesystem::path> gpu_profile_file{};
+	std::optional<std::filesystem::path> cpu_trace_file{};
+	std::optional<std::filesystem::path> benchmark_file{};
+	std::optional<std::filesystem::path> camera_path_file{};
+	std::optional<std::filesystem::path> record_path_file{};
+	bool cdlod{false};
+	bool props{false};
+	bool verify_heightfield{false};
+
+	bool should_capture(std::size_t frame) const noexcept;
+	bool is_last_frame(std::size_t frame) const noexcept;
+	/* Whether every run must render the same frames, in which case nothing may depend on thread timing.
+	 * True for benchmarks, replayed camera paths, headless runs and captures */
+	bool reproducible() const noexcept;
+
+	static RunOptions parse(int argc, char const* const* argv);
+
+	static std::size_t constexpr DEFAULT_HEADLESS_FRAMES = 300u;
+	static std::size_t constexpr DEFAULT_BENCHMARK_FRAMES = 1200u;
+};
+
+#endif
@@ -1,32 +1,140 @@
-#include "context.h"
+#include "cpu_profiler.h"
 #include "shader.h"
 #include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <poll.h>
 #include <stack>
 #include <sstream>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 Shader::~Shader() {
 	LOG("Deleting shader");
 
+	/* Never completed, e.g. a Future that was dropped or failed */
+	if(!registered_) {
+		for(auto id : pending_stages_)
+			glDeleteShader(id);
+		glDeleteProgram(program_);
+		return;
+	}
+
 	std::lock_guard<std::mutex> lock{ics_mutex_};
 	instances_.erase(
 		std::remove_if(std::begin(instances_), 
 					   std::end(instances_), 
 					   [this](auto ref_wrapper) {
 			return std::addressof(ref_wrapper.get()) == this;
-		}));
+		}),
+		std::end(instances_));
 
 	if(instances_.size() == 0u) {
 		delete_buffers();
 		#ifndef RESTRICT_THREAD_USAGE
-		LOG("Joining updater thread with id ", updater_thread_.get_id());
-		halt_execution_ = true;
-		updater_thread_.join();
+		if(!halt_execution_) {
+			LOG("Joining updater thread with id ", updater_thread_.get_id());
+			halt_execution_ = true;
+			std::uint64_t const wake = 1u;
+			if(write(wake_fd_, &wake, sizeof(wake)) < 0) {
+				ERR_LOG_WARN("Unable to wake updater thread: ", std::strerror(errno));
+			}
+			updater_thread_.join();
+			close_watch();
+		}
 		#endif
 	}
 }
 
+Shader::Future::Future(std::shared_ptr<Shader> shader) noexcept : shader_{std::move(shader)} { }
+
+bool Shader::Future::ready() const {
+	return shader_->link_completed();
+}
+
+std::shared_ptr<Shader> Shader::Future::get() {
+	auto shader = std::move(shader_);
+	shader->complete();
+	return shader;
+}
+
+void Shader::complete() {
+	if(!pending_stages_.empty()) {
+		for(auto id : pending_stages_) {
+			auto result = assert_shader_status_ok(id, StatusQuery::Compile);
+			if(result.outcome == Outcome::Failure) {
+				for(auto stage : pending_stages_)
+					glDeleteShader(stage);
+				glDeleteProgram(program_);
+				pending_stages_.clear();
+				program_ = 0u;
+				throw ShaderCompilationException{result.data.value()};
+			}
+		}
+
+		auto [outcome, data] = end_link(program_, pending_stages_);
+		pending_stages_.clear();
+		if(outcome == Outcome::Failure) {
+			program_ = 0u;
+			throw ShaderLinkingException{std::get<std::string>(data)};
+		}
+		LOG("Linking successful, assigning new id ", program_);
+
+		store_binary(*pending_key_, program_);
+		pending_key_.reset();
+	}
+
+	std::size_t instances_size;
+	{
+		std::lock_guard<std::mutex> lock{ics_mutex_};
+		instances_size = instances_.size();
+	}
+	if(!instances_size) {
+		setup_texture_environment(Viewport::width, Viewport::height);
+		bind_main_framebuffer();
+	}
+
+	std::lock_guard<std::mutex> lock{ics_mutex_};
+
+	LOG("Marking instance for automatic updating");
+	instances_.push_back(std::ref(*this));
+	registered_ = true;
+	
+	#ifndef RESTRICT_THREAD_USAGE
+	if(halt_execution_ && open_watch()) {
+		LOG("Creating separate thread for execution");
+		halt_execution_ = false;
+		updater_thread_ = std::thread(monitor_source_files);
+		LOG("Thread with id", updater_thread_.get_id(), " successfully created");
+	}
+	#endif
+	watch(dependencies_);
+}
+
+bool Shader::link_completed() const {
+	if(pending_stages_.empty() || !GLEW_KHR_parallel_shader_compile)
+		return true;
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(program_, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+void Shader::enable_parallel_compile() {
+	static bool enabled = false;
+	if(enabled || !GLEW_KHR_parallel_shader_compile)
+		return;
+
+	/* Let the driver pick the number of threads */
+	LOG("Enabling parallel shader compilation");
+	glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+	enabled = true;
+}
+
 void Shader::enable() const {
 	enable(program_);
 }
@@ -51,6 +159,29 @@ void Shader::set_reload_callback(callback_func func) {
 	reload_callback_ = func;
 }
 
+void Shader::reload_changed() {
+	if(!changes_pending_.load(std::memory_order_acquire))
+		return;
+
+	std::set<std::filesystem::path> changed;
+	{
+		std::lock_guard<std::mutex> lock{changes_mutex_};
+		changed.swap(changed_files_);
+		changes_pending_ = false;
+	}
+
+	std::lock_guard<std::mutex> lock{ics_mutex_};
+	for(auto& shader : instances_) {
+		auto const& dependencies = shader.get().dependencies_;
+		bool const affected = std::any_of(std::begin(dependencies), std::end(dependencies), [&changed](auto const& file) {
+			return changed.count(file) > 0u;
+		});
+
+		if(affected && shader.get().reload() && reload_callback_)
+			(*reload_callback_)(shader.get());
+	}
+}
+
 void Shader::bind_main_framebuffer() noexcept {
 	glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
 }
@@ -73,6 +204,22 @@ GLuint Shader::scene_texture() noexcept {
     return texture_buffer_;
 }
 
+std::size_t Shader::intern_uniform(std::string const& name) const {
+	auto const it = std::find_if(std::begin(interned_uniforms_), std::end(interned_uniforms_), [&name](auto const& interned) {
+		return interned.name == name;
+	});
+	if(it != std::end(interned_uniforms_))
+		return static_cast<std::size_t>(it - std::begin(interned_uniforms_));
+
+	GLint const location = glGetUniformLocation(program_, name.c_str());
+	if(location == -1) {
+		LOG_WARN("Uniform ", name, " is not active in program ", program_);
+	}
+
+	interned_uniforms_.push_back({name, location, std::nullopt});
+	return interned_uniforms_.size() - 1u;
+}
+
 GLuint Shader::program_id() const {
 	return program_;
 }
@@ -139,12 +286,13 @@ void Shader::delete_buffers() noexcept {
 	glDeleteRenderbuffers(1, &rbo_);
 }
 
-Result<Shader::ErrorType, std::string> Shader::read_source(std::string const& source){
+Result<Shader::ErrorType, std::string> Shader::read_source(std::string const& source, std::vector<std::filesystem::path>& dependencies){
 	/* Every time an include directive is found, push stream with file to be included onto
  	 * the stack */
 	std::stack<std::ifstream, std::vector<std::ifstream>> streams;
 
 	streams.push(std::ifstream{source});
+	dependencies.push_back(std::filesystem::path{source}.lexically_normal());
 	
 	if(!streams.top().is_open())
 		return { Outcome::Failure, std::make_tuple(ErrorType::FileIO, "Unable to open " + source + " for reading\n") };
@@ -170,6 +318,7 @@ Result<Shader::ErrorType, std::string> Shader::read_source(std::string const& so
 				if(result.outcome == Outcome::Failure)
 					return result;
 
+				dependencies.push_back(std::filesystem::path{std::get<1>(result.data)}.lexically_normal());
 				std::ifstream file{std::get<1>(result.data)};
 				
 				if(!file.is_open())
@@ -242,16 +391,22 @@ Result<Shader::ErrorType, std::string> Shader::process_include_directive(std::st
 }
 
 Result<GLuint, std::string> Shader::compile(std::string const& source, Type type){
+	GLuint id = begin_compile(source, type);
+	
+	auto result = assert_shader_status_ok(id, StatusQuery::Compile);	
+
+	return { result.outcome, std::make_tuple(id, result.data.value_or(std::string{})) };
+}
+
+GLuint Shader::begin_compile(std::string const& source, Type type){
 	GLuint id = glCreateShader(to_GLenum(type));
 
 	auto c_source = source.c_str();
 
 	glShaderSource(id, 1, &c_source, nullptr);
 	glCompileShader(id);
-	
-	auto result = assert_shader_status_ok(id, StatusQuery::Compile);	
 
-	return { result.outcome, std::make_tuple(id, result.data.value_or(std::string{})) };
+	return id;
 }
 
 Result<std::optional<std::string>> Shader::assert_shader_status_ok(GLuint id, StatusQuery sq){
@@ -286,55 +441,206 @@ GLenum constexpr Shader::to_GLenum(Type type) noexcept {
 	return static_cast<GLenum>(enum_value(type));
 }
 
+disk_cache::Key Shader::binary_key(std::string const* sources) const {
+	disk_cache::Key key{"program"};
+	for(auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+		auto const* str = reinterpret_cast<char const*>(glGetString(name));
+		key.add(std::string{str ? str : ""});
+	}
+
+	for(auto i = 0u; i < sources_.size(); i++)
+		key.add(to_GLenum(sources_[i].type)).add(sources[i]);
+
+	return key;
+}
+
+std::optional<GLuint> Shader::load_binary(disk_cache::Key const& key) {
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if(!formats)
+		return std::nullopt;
+
+	auto try_binary = [](GLenum format, void const* data, std::size_t size) -> std::optional<GLuint> {
+		GLuint const program = glCreateProgram();
+		glProgramBinary(program, format, data, static_cast<GLsizei>(size));
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if(linked)
+			return program;
+
+		glDeleteProgram(program);
+		return std::nullopt;
+	};
+
+	/* Identical programs, e.g. the two blur passes, are only compiled once */
+	std::string const id{std::begin(key.bytes()), std::end(key.bytes())};
+	if(auto it = binaries_.find(id); it != std::end(binaries_)) {
+		if(auto program = try_binary(it->second.format, it->second.data.data(), it->second.data.size()))
+			return program;
+	}
+
+	auto entry = disk_cache::load(key);
+	if(!entry)
+		return std::nullopt;
+
+	auto const [format, format_count] = entry->section<GLenum>(0u);
+	auto const [data, size] = entry->section<unsigned char>(1u);
+	if(format_count != 1u || !size)
+		return std::nullopt;
+
+	auto program = try_binary(*format, data, size);
+	if(!program) {
+		LOG_WARN("Program binary was rejected by the driver, compiling from source");
+		return std::nullopt;
+	}
+
+	binaries_.insert_or_assign(id, ProgramBinary{*format, {data, data + size}});
+	return program;
+}
+
+void Shader::store_binary(disk_cache::Key const& key, GLuint program) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if(length <= 0)
+		return;
+
+	ProgramBinary binary{0u, std::vector<unsigned char>(static_cast<std::size_t>(length))};
+	GLsizei written = 0;
+	glGetProgramBinary(program, length, &written, &binary.format, binary.data.data());
+	if(written <= 0)
+		return;
+	binary.data.resize(static_cast<std::size_t>(written));
+
+	disk_cache::store(key, { disk_cache::section(&binary.format, 1u), disk_cache::section(binary.data) });
+	binaries_.insert_or_assign(std::string{std::begin(key.bytes()), std::end(key.bytes())}, std::move(binary));
+}
+
+bool Shader::open_watch() {
+	inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	wake_fd_ = eventfd(0u, EFD_CLOEXEC);
+
+	if(inotify_fd_ < 0 || wake_fd_ < 0) {
+		ERR_LOG_WARN("Unable to watch shader sources, live reloading is disabled: ", std::strerror(errno));
+		close_watch();
+		return false;
+	}
+
+	return true;
+}
+
+void Shader::close_watch() {
+	if(inotify_fd_ >= 0)
+		close(inotify_fd_);
+	if(wake_fd_ >= 0)
+		close(wake_fd_);
+	inotify_fd_ = wake_fd_ = -1;
+
+	std::lock_guard<std::mutex> lock{watch_mutex_};
+	watched_directories_.clear();
+}
+
+void Shader::watch(std::vector<std::filesystem::path> const& files) {
+	std::lock_guard<std::mutex> lock{watch_mutex_};
+	if(inotify_fd_ < 0)
+		return;
+
+	/* Directories are watched rather than files, as editors often save by replacing the file */
+	for(auto const& file : files) {
+		auto directory = file.parent_path();
+		if(directory.empty())
+			directory = ".";
+
+		int const wd = inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if(wd < 0) {
+			ERR_LOG_WARN("Unable to watch ", directory.string(), ": ", std::strerror(errno));
+			continue;
+		}
+		watched_directories_.insert({wd, std::move(directory)});
+	}
+}
+
 void Shader::monitor_source_files() {
-	using namespace std::chrono_literals;
-	Context const shared_context{"", 1u, 1u, false, true};
+	PROFILE_THREAD("shader_monitor");
+
+	std::array<pollfd, 2> fds{{ { inotify_fd_, POLLIN, 0 }, { wake_fd_, POLLIN, 0 } }};
+	alignas(inotify_event) std::array<char, 4096> buffer;
+	std::set<std::filesystem::path> changed;
 
 	while(!halt_execution_) {
-		{
-			std::lock_guard<std::mutex> lock{ics_mutex_};
-			for(auto& shader : instances_){
-				for(auto& source : shader.get().sources_) {
-					if(source.has_changed()) {
-						if(shader.get().reload()) {
-							if(reload_callback_)
-								(*reload_callback_)(shader.get());
-						}
-						else
-							source.update_write_time(); /* Dont' attempt to reload unless a new change is made */
-						break;
-					}
-				}
+		/* Sleep until something is written, then gather writes until they settle */
+		int const timeout = changed.empty() ? -1 : static_cast<int>(debounce_.count());
+		int const ready = poll(fds.data(), fds.size(), timeout);
+
+		if(ready < 0) {
+			if(errno == EINTR)
+				continue;
+			ERR_LOG_WARN("Polling shader sources failed, live reloading is disabled: ", std::strerror(errno));
+			return;
+		}
+
+		if(!ready) {
+			std::lock_guard<std::mutex> lock{changes_mutex_};
+			changed_files_.merge(changed);
+			changed.clear();
+			changes_pending_.store(true, std::memory_order_release);
+			continue;
+		}
+
+		if(!(fds[0].revents & POLLIN))
+			continue;
+
+		PROFILE_ZONE("read_shader_events");
+		for(ssize_t size; (size = read(inotify_fd_, buffer.data(), buffer.size())) > 0;) {
+			std::lock_guard<std::mutex> lock{watch_mutex_};
+			for(auto offset = 0u; offset < static_cast<std::size_t>(size);) {
+				auto const* event = reinterpret_cast<inotify_event const*>(buffer.data() + offset);
+				offset += sizeof(inotify_event) + event->len;
+
+				auto it = watched_directories_.find(event->wd);
+				if(event->len && it != std::end(watched_directories_))
+					changed.insert((it->second / event->name).lexically_normal());
 			}
 		}
-		std::this_thread::sleep_for(2s);
 	}
 }
 
 bool Shader::reload() {
+	PROFILE_ZONE("shader_reload");
 	LOG("Change to shader source detected, reloading...");
 	
 	std::vector<GLuint> shader_ids(sources_.size());
+	std::vector<std::filesystem::path> dependencies;
 	Result<GLuint, std::string> result;
 
+	/* Keep watching the current files as well as new ones, e.g. includes that do not exist yet */
+	auto abort_reload = [this, &dependencies]() {
+		dependencies_.insert(std::end(dependencies_), std::begin(dependencies), std::end(dependencies));
+		std::sort(std::begin(dependencies_), std::end(dependencies_));
+		dependencies_.erase(std::unique(std::begin(dependencies_), std::end(dependencies_)), std::end(dependencies_));
+		watch(dependencies_);
+		return false;
+	};
+
 	for(auto [idx, id] : enumerate(shader_ids)) {
 		auto path = sources_[idx].path.string();
 
 		LOG("Reading source ", sources_[idx].path.stem().string());
-		auto [outcome, data] = read_source(path);
+		auto [outcome, data] = read_source(path, dependencies);
 		auto& [error_type, content] = data;
 
 		if(outcome == Outcome::Failure) {
 			for(auto i = 0u; i < idx; i++)
 				glDeleteShader(shader_ids[i]);
 
+
 			if(error_type == ErrorType::FileIO){
 				ERR_LOG_WARN("Error reading source file when updating. Process returned message \'", content, "\'");
 			}
 			else if(error_type == ErrorType::Include) {
 				ERR_LOG_WARN("Error including source file when updating. Process returned message \'", content, "\'");
 			}
-			return false;
+			return abort_reload();
 		}
 		LOG("Compiling ", sources_[idx].path.stem().string());
 		result = compile(content, sources_[idx].type);
@@ -345,30 +651,22 @@ bool Shader::reload() {
 				glDeleteShader(shader_ids[i]);
 						
 			ERR_LOG_WARN("Error compiling shader, process returned message \'", std::get<1>(result.data), "\'");
-			return false;
+			return abort_reload();
 		}
 	}
 	LOG("Relinking shader with id ", program_);
 	auto [outcome, data] = link(shader_ids);
 
 	if(outcome == Outcome::Failure) {
-		ERR_LOG_CRIT("Error linking shader. Process returned message \'", std::get<std::string>(data), "\'. Attempting to schedule relinking for next cycle...");
-		for(auto& source : sources_) {
-			auto [touch_outcome, opt] = source.touch();
-			if(touch_outcome == Outcome::Failure) {
-				ERR_LOG_CRIT("Failed to schedule relinking. \'", opt.value(), "\' was returned. The operation will be  aborted");
-				return false;
-			}
-		}
-		ERR_LOG("Scheduling successful, another attempt will be made shortly");
-		return false;
+		ERR_LOG_CRIT("Error linking shader. Process returned message \'", std::get<std::string>(data), "\'. Another attempt will be made on the next change");
+		return abort_reload();
 	}
 	glDeleteProgram(program_);
 	program_ = std::get<GLuint>(data);
 
 	LOG("Shader successfully relinked and assigned new id", program_);
-	for(auto& source : sources_)
-		source.update_write_time();
+	dependencies_ = std::move(dependencies);
+	watch(dependencies_);
 
 	LOG("Updating internal uniform locations");
 	update_internal_uniform_locations();
@@ -377,6 +675,10 @@ bool Shader::reload() {
 	enable();
 	for(auto const& [handle, data] : stored_uniform_data_)
 		upload_uniform(handle, data);
+	for(auto const& interned : interned_uniforms_) {
+		if(interned.stored)
+			upload_uniform(program_, interned.location, *interned.stored);
+	}
 
 	return true;
 }
@@ -384,12 +686,11 @@ bool Shader::reload() {
 void Shader::update_internal_uniform_locations() const {
 	for(auto& [handle, location] : cached_uniform_locations_)
 		location = glGetUniformLocation(program_, handle.c_str());
+	for(auto& interned : interned_uniforms_)
+		interned.location = glGetUniformLocation(program_, interned.name.c_str());
 }
 
-std::string const Shader::PROJECTION_UNIFORM_NAME = "ufrm_projection";
-std::string const Shader::VIEW_UNIFORM_NAME = "ufrm_view";
 std::string const Shader::MODEL_UNIFORM_NAME = "ufrm_model";
-std::string const Shader::TIME_UNIFORM_NAME = "ufrm_time";
 
 GLuint Shader::fbo_{};
 GLuint Shader::rbo_{};
@@ -400,22 +701,30 @@ std::mutex Shader::ics_mutex_{};
 std::thread Shader::updater_thread_{};
 std::vector<std::reference_wrapper<Shader>> Shader::instances_{};
 typename Shader::callback_func Shader::reload_callback_{nullptr};
+int Shader::inotify_fd_{-1};
+int Shader::wake_fd_{-1};
+std::mutex Shader::watch_mutex_{};
+std::unordered_map<int, std::filesystem::path> Shader::watched_directories_{};
+std::mutex Shader::changes_mutex_{};
+std::set<std::filesystem::path> Shader::changed_files_{};
+std::atomic_bool Shader::changes_pending_{false};
+std::unordered_map<std::string, Shader::ProgramBinary> Shader::binaries_{};
 
 /* Shader::Source */
-Shader::Source::Source(std::string const& file, Type t) : path{file}, last_write{std::filesystem::file_time_type::clock::now()}, type{t} { }
+Shader::Source::Source(std::string const& file, Type t) : path{file}, type{t} { }
 
-Shader::Source::Source(std::filesystem::path const& file, Type t) : path{file}, last_write{std::filesystem::file_time_type::clock::now()}, type{t} { }
+Shader::Source::Source(std::filesystem::path const& file, Type t) : path{file}, type{t} { }
 
-Shader::Source::Source(std::string&& file, Type t) : path{std::move(file)}, last_write{std::filesystem::file_time_type::clock::now()}, type{t} { }
+Shader::Source::Source(std::string&& file, Type t) : path{std::move(file)}, type{t} { }
 
-Shader::Source::Source(std::filesystem::path&& file, Type t) : path{std::move(file)}, last_write{std::filesystem::file_time_type::clock::now()}, type{t} { }
+Shader::Source::Source(std::filesystem::path&& file, Type t) : path{std::move(file)}, type{t} { }
 
-Shader::Source::Source(Source const& other) : last_write{other.last_write}, type{other.type} {
+Shader::Source::Source(Source const& other) : type{other.type} {
 	reconstruct();
 	path = other.path;
 }
 
-Shader::Source::Source(Source&& other) : last_write{std::move(other.last_write)}, type{other.type} {
+Shader::Source::Source(Source&& other) : type{other.type} {
 	reconstruct();
 	path = std::move(other.path);
 }
@@ -423,7 +732,6 @@ Shader::Source::Source(Source&& other) : last_write{std::move(other.last_write)}
 Shader::Source& Shader::Source::operator=(Source const& other) & {
 	reconstruct();
 	path = other.path;
-	last_write = other.last_write;
 	type = other.type;
 	return *this;
 }
@@ -431,55 +739,10 @@ Shader::Source& Shader::Source::operator=(Source const& other) & {
 Shader::Source& Shader::Source::operator=(Source&& other) & {
 	reconstruct();
 	path = std::move(other.path);
-	last_write = std::move(other.last_write);
 	type = other.type;
 	return *this;
 }
 
-
-Result<std::optional<std::string>> Shader::Source::touch() noexcept {
-	namespace fs = std::filesystem;
-
-    auto const now = std::filesystem::file_time_type::clock::now();
-	std::error_code err;
-	
-	fs::last_write_time(path, now, err);
-	if(err)
-		return { Outcome::Failure, std::optional<std::string>{err.message()} };
-
-	return { Outcome::Success, std::nullopt };
-}
-
-void Shader::Source::update_write_time(std::filesystem::file_time_type time) noexcept {
-	last_write = time;
-
-}
-Result<std::variant<std::string, std::filesystem::file_time_type>>
-	Shader::Source::get_last_write_time() const noexcept {
-	namespace fs = std::filesystem;
-	std::error_code err{};
-
-	auto time = fs::last_write_time(path, err);
-	if(err)
-		return { Outcome::Failure, err.message() };
-
-	return { Outcome::Success, time };
-}
-
-bool Shader::Source::has_changed() {
-	namespace fs = std::filesystem;
-	auto [outcome, data] = get_last_write_time();
-	
-	if(outcome == Outcome::Failure) {
-		ERR_LOG_WARN("Failed to update write time for shader created from source", path.stem(), ". Process returned error code with message: \'", std::get<std::string>(data), "\'. No update is possible");
-
-		return false;
-	}
-	auto time = std::get<fs::file_time_type>(data);
-	
-	return time > last_write;
-}
-
 void Shader::Source::reconstruct() {
 	namespace fs = std::filesystem;
 	new (&path) fs::path;
@@ -2,6 +2,7 @@
 #define SHADER_H
 
 #pragma once
+#include "disk_cache.h"
 #include "exception.h"
 #include "iter.h"
 #include "logger.h"
@@ -24,6 +25,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -49,6 +51,30 @@ class Shader {
 		Shader(Sources const&... src);
 
 		~Shader();
+
+		/* Shader that is still being compiled, see compile_async */
+		class Future {
+			public:
+				/* Never blocks. Always true if the driver cannot compile in parallel */
+				bool ready() const;
+
+				/* Blocks until the shader is ready and throws the same exceptions as the constructor
+				 * would. May only be called once */
+				std::shared_ptr<Shader> get();
+
+			private:
+				friend class Shader;
+				explicit Future(std::shared_ptr<Shader> shader) noexcept;
+
+				std::shared_ptr<Shader> shader_;
+		};
+
+		/* Takes the same arguments as the constructor, but returns as soon as the sources have been read and
+		 * handed to the driver. Programs submitted one after another are compiled in parallel if
+		 * GL_KHR_parallel_shader_compile is supported, so all of them should be submitted before calling get
+		 * on any */
+		template <typename... Sources>
+		static Future compile_async(Sources const&... src);
 		
 		Shader(Shader const&) = delete;
 		Shader& operator=(Shader const&) = delete;
@@ -59,6 +85,11 @@ class Shader {
 
 		static void set_reload_callback(callback_func);
 
+		/* Reloads the shaders whose sources, or files included by them, have been written since the last
+		 * call. Changes are detected on a separate thread, but reloading must happen on the thread owning
+		 * the context, so this should be called once per frame. Cheap when nothing has changed */
+		static void reload_changed();
+
 		static void bind_main_framebuffer() noexcept;
 		static void bind_default_framebuffer() noexcept;
 		static void bind_scene_texture() noexcept;
@@ -69,8 +100,29 @@ class Shader {
 		static void reallocate_textures();
 
 		GLuint program_id() const;
-		
-		/* (Indirect) Wrappers for glUniform */
+
+		/* Handle to a uniform of type T of the shader that created it, see uniform(). Values of any other type
+		 * cannot be uploaded through it */
+		template <typename T>
+		class Uniform {
+			public:
+				Uniform() = default;
+
+			private:
+				friend class Shader;
+				Uniform(Shader const* shader, std::size_t index) noexcept : shader_{shader}, index_{index} { }
+
+				Shader const* shader_{nullptr};
+				std::size_t index_{INVALID};
+				static std::size_t constexpr INVALID = ~std::size_t{0u};
+		};
+
+		/* Looks up the uniform's location once, and again whenever the shader is reloaded. Should be called
+		 * outside of the render loop, and the handle kept, as uploading through a handle requires no lookup */
+		template <typename T>
+		Uniform<T> uniform(std::string const& name) const;
+
+		/* (Indirect) Wrappers for glProgramUniform, no program needs to be bound */
 		/* Pass any arithmetic fundamental type, glm::vec (except glm::bvec) or glm::mat and the correct glUniform function will be
  		 * deduced. As the deduction relies on the type passed, pointers are not supported.
  		 * 	- If passing arithmetic types, any number between 1 and 4 works and calls the correct glUniform.
@@ -78,17 +130,19 @@ class Shader {
 		template <bool Store = false, typename... Args>
 		void upload_uniform(std::string const& name, Args&&... args) const;						/* Stores uniform locations in hash map */
 
+		/* Throws BadUniformParametersException if handle was created by another shader or default constructed */
+		template <bool Store = false, typename T>
+		void upload_uniform(Uniform<T> handle, T const& value) const;
+
 		template <bool Store = false, typename... Args>
 		static void upload_to_all(std::string const& name, Args&&... args);
 
 		bool operator==(Shader const& other) const noexcept;
 		bool operator!=(Shader const& other) const noexcept;
 
-		static std::string const PROJECTION_UNIFORM_NAME;
-		static std::string const VIEW_UNIFORM_NAME;
 		static std::string const MODEL_UNIFORM_NAME;
-		static std::string const TIME_UNIFORM_NAME;
 	private:
+		struct Deferred { };
 		enum class StatusQuery { Compile, Link };
 		enum class ErrorType { None,
 							   ArgumentMismatch,
@@ -110,26 +164,35 @@ class Shader {
 			Source& operator=(Source const& other) &;
 			Source& operator=(Source&& other) &;
 
-			Result<std::optional<std::string>> touch() noexcept;
-			void update_write_time(std::filesystem::file_time_type time = std::filesystem::file_time_type::clock::now()) noexcept;
-
-			Result<std::variant<std::string, std::filesystem::file_time_type>>
-				get_last_write_time() const noexcept;
-			bool has_changed();
-
 			std::filesystem::path path{};
-			std::filesystem::file_time_type last_write{};
 			Type type{};
 
 			private:
 				void reconstruct();
 		};
 
+		struct ProgramBinary {
+			GLenum format;
+			std::vector<unsigned char> data;
+		};
+
+		struct InternedUniform {
+			std::string name;
+			GLint location;
+			std::optional<glm::mat4> stored;
+		};
+
 		std::atomic<GLuint> program_{}; /* Shader program id */
 		std::unordered_map<std::string, GLint> mutable cached_uniform_locations_{};
 		std::map<std::string, glm::mat4> mutable stored_uniform_data_{};
+		std::vector<InternedUniform> mutable interned_uniforms_{};
 		std::vector<Source> sources_;
+		std::vector<std::filesystem::path> dependencies_{}; /* Sources and every file included by them */
+		std::vector<GLuint> pending_stages_{};				/* Submitted but not yet checked, see submit */
+		std::optional<disk_cache::Key> pending_key_{};
+		bool registered_{false};
 		static std::size_t constexpr depth_{8u}; /* Max recursive include depth */
+		static std::chrono::milliseconds constexpr debounce_{100}; /* Quiet period ending a burst of writes */
 
 		static GLuint fbo_;
 		static GLuint rbo_;
@@ -141,8 +204,29 @@ class Shader {
 		static std::vector<std::reference_wrapper<Shader>> instances_;
 		static callback_func reload_callback_;
 
+		/* File watching, see monitor_source_files */
+		static int inotify_fd_;
+		static int wake_fd_;
+		static std::mutex watch_mutex_;
+		static std::unordered_map<int, std::filesystem::path> watched_directories_;
+		static std::mutex changes_mutex_;
+		static std::set<std::filesystem::path> changed_files_;
+		static std::atomic_bool changes_pending_;
+		/* Binaries of the programs linked so far, by the bytes of their keys */
+		static std::unordered_map<std::string, ProgramBinary> binaries_;
+
+		template <typename... Sources>
+		Shader(Deferred, Sources const&... src);
+
 		template <std::size_t N>
 		void init();
+		/* Reads the sources and starts compiling and linking, or loads a cached binary */
+		template <std::size_t N>
+		void submit();
+		/* Waits for the program submitted, throws on failure and marks the instance for updating */
+		void complete();
+		bool link_completed() const;
+		static void enable_parallel_compile();
 	
 		static void setup_texture_environment(int width, int height);
 		static void delete_buffers() noexcept;
@@ -152,13 +236,26 @@ class Shader {
 		template <typename... Args, std::size_t... Is>
 		static bool constexpr odd_parameters_acceptable(odd_index_sequence<Is...>);
 		
-		static Result<ErrorType, std::string> read_source(std::string const& source);
+		/* Appends the source and every file it includes to dependencies, also those that could not be opened */
+		static Result<ErrorType, std::string> read_source(std::string const& source, std::vector<std::filesystem::path>& dependencies);
 		static std::string format_header_guard(std::string path);
 		static Result<ErrorType, std::string> process_include_directive(std::string const& directive, std::string const& source, std::size_t idx);
 		static Result<GLuint, std::string> compile(std::string const& source, Type type);
+		static GLuint begin_compile(std::string const& source, Type type);
 
 		template <typename T, typename = std::enable_if_t<is_container_v<T>>>
 		static Result<std::variant<GLuint, std::string>> link(T const& ids);
+		template <typename T, typename = std::enable_if_t<is_container_v<T>>>
+		static GLuint begin_link(T const& ids);
+		/* Checks the status of the program and deletes the shaders ids, as well as the program on failure */
+		template <typename T, typename = std::enable_if_t<is_container_v<T>>>
+		static Result<std::variant<GLuint, std::string>> end_link(GLuint program_id, T const& ids);
+
+		/* Program binaries are cached by the preprocessed sources, given in the order of sources_, and
+		 * the driver. Binaries rejected by the driver are ignored and later replaced */
+		disk_cache::Key binary_key(std::string const* sources) const;
+		static std::optional<GLuint> load_binary(disk_cache::Key const& key);
+		static void store_binary(disk_cache::Key const& key, GLuint program);
 
 		static Result<std::optional<std::string>> assert_shader_status_ok(GLuint id, StatusQuery sq);
 
@@ -168,12 +265,18 @@ class Shader {
 		static GLenum constexpr to_GLenum(Type type) noexcept;
 
 		template <typename... Args>
-		static void upload_uniform(GLint location, Args&&... args);
+		static void upload_uniform(GLuint program, GLint location, Args&&... args);
 
+		static bool open_watch();
+		static void close_watch();
+		static void watch(std::vector<std::filesystem::path> const& files);
 		static void monitor_source_files();
 		bool reload();
 		void update_internal_uniform_locations() const;
 
+		/* Index of name in interned_uniforms_, appended if not yet interned */
+		std::size_t intern_uniform(std::string const& name) const;
+
 		static Viewport viewport_info() noexcept;
 };
 
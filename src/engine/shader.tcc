@@ -12,6 +12,26 @@ Shader::Shader(Sources const&... src) : sources_(sizeof...(Sources)/2) {
 	generate_source<0u, pack_size/2u>(src...); 
 	init<pack_size/2>();
 }
+
+template <typename... Sources>
+Shader::Shader(Deferred, Sources const&... src) : sources_(sizeof...(Sources)/2) {
+	std::size_t constexpr pack_size = sizeof...(Sources);
+
+	static_assert(pack_size > 0u, "Cannot create empty shader");
+
+    static_assert(even_parameters_acceptable<Sources...>(even_index_sequence_for<Sources...>{}), 
+                  "Even arguments must be convertible to std::string");
+    static_assert(odd_parameters_acceptable<Sources...>(odd_index_sequence_for<Sources...>{}),   
+                  "Odd arguments must be of type Shader::Type");
+
+	generate_source<0u, pack_size/2u>(src...); 
+	submit<pack_size/2>();
+}
+
+template <typename... Sources>
+typename Shader::Future Shader::compile_async(Sources const&... src) {
+	return Future{std::shared_ptr<Shader>{new Shader{Deferred{}, src...}}};
+}
 	
 template <typename... Args, std::size_t... Is>
 bool constexpr Shader::even_parameters_acceptable(even_index_sequence<Is...>) {
@@ -32,78 +52,72 @@ void Shader::generate_source(std::string const& path, Type type, Sources const&.
 
 template <std::size_t N>
 void Shader::init() {
-	std::array<GLuint, N> shader_ids;
-	Result<GLuint, std::string> result;
+	submit<N>();
+	complete();
+}
 
-	for(auto [idx, id] : enumerate(shader_ids)) {
+template <std::size_t N>
+void Shader::submit() {
+	std::array<std::string, N> contents;
+
+	for(auto [idx, content] : enumerate(contents)) {
 		auto path = sources_[idx].path.string();
 
 		LOG("Reading source ", sources_[idx].path.stem().string());
-		auto [outcome, data] = read_source(path);
-		auto& [error_type, content] = data;
+		auto [outcome, data] = read_source(path, dependencies_);
+		auto& [error_type, text] = data;
 
 		if(outcome == Outcome::Failure) {
-			for(auto i = 0u; i < idx; i++)
-				glDeleteShader(shader_ids[i]);
-
 			if(error_type == ErrorType::FileIO)
-				throw FileIOException{content};
+				throw FileIOException{text};
 			else if(error_type == ErrorType::Include)
-				throw ShaderIncludeException{content};
-		}
-	
-		LOG("Compiling ", sources_[idx].path.stem().string());
-		result = compile(content, sources_[idx].type);
-		id = std::get<0>(result.data);
-
-		if(result.outcome == Outcome::Failure) {
-			for(auto i = 0u; i < idx + 1; i++)
-				glDeleteShader(shader_ids[i]);
-			throw ShaderCompilationException{std::get<1>(result.data)};
+				throw ShaderIncludeException{text};
 		}
-	}
-	LOG("Linking program");
-	auto [outcome, data] = link(shader_ids);
-	if(outcome == Outcome::Failure)
-		throw ShaderLinkingException{std::get<std::string>(data)};
-
-	program_ = std::get<GLuint>(data);
-	LOG("Linking successful, assigning new id ", program_);
 
-	std::size_t instances_size;
-	{
-		std::lock_guard<std::mutex> lock{ics_mutex_};
-		instances_size = instances_.size();
+		content = std::move(text);
 	}
-	if(!instances_size) {
-		setup_texture_environment(Viewport::width, Viewport::height);
-		bind_main_framebuffer();
+
+	auto key = binary_key(contents.data());
+	if(auto cached = load_binary(key)) {
+		program_ = *cached;
+		LOG("Loaded program binary, assigning new id ", program_);
+		return;
 	}
 
-	std::lock_guard<std::mutex> lock{ics_mutex_};
+	enable_parallel_compile();
 
-	LOG("Marking instance for automatic updating");
-	instances_.push_back(std::ref(*this));
-	
-	#ifndef RESTRICT_THREAD_USAGE
-	if(halt_execution_) {
-		LOG("Creating separate thread for execution");
-		halt_execution_ = false;
-		updater_thread_ = std::thread(monitor_source_files);
-		LOG("Thread with id", updater_thread_.get_id(), " successfully created");
+	/* Statuses are not queried until complete, so that the driver is free to compile in the background */
+	pending_stages_.reserve(N);
+	for(auto i = 0u; i < N; i++) {
+		LOG("Compiling ", sources_[i].path.stem().string());
+		pending_stages_.push_back(begin_compile(contents[i], sources_[i].type));
 	}
-	#endif
+
+	LOG("Linking program");
+	program_ = begin_link(pending_stages_);
+	pending_key_ = std::move(key);
 }
 
 template <typename T, typename>
 Result<std::variant<GLuint, std::string>> Shader::link(T const& ids) {
+	return end_link(begin_link(ids), ids);
+}
+
+template <typename T, typename>
+GLuint Shader::begin_link(T const& ids) {
 	GLuint program_id = glCreateProgram();
 
 	for(auto id : ids)
 		glAttachShader(program_id, id);
 
+	glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(program_id);
 
+	return program_id;
+}
+
+template <typename T, typename>
+Result<std::variant<GLuint, std::string>> Shader::end_link(GLuint program_id, T const& ids) {
 	auto result = assert_shader_status_ok(program_id, StatusQuery::Link);
 
 	for(auto id : ids) {
@@ -134,8 +148,27 @@ void Shader::upload_uniform(std::string const& name, Args&&... args) const {
 	
 	GLint location = it->second;	
 	
-	enable();
-	upload_uniform(location, std::forward<Args>(args)...);
+	upload_uniform(program_, location, std::forward<Args>(args)...);
+}
+
+template <typename T>
+typename Shader::Uniform<T> Shader::uniform(std::string const& name) const {
+	return Uniform<T>{this, intern_uniform(name)};
+}
+
+template <bool Store, typename T>
+void Shader::upload_uniform(Uniform<T> handle, T const& value) const {
+	/* Default constructed handles belong to no shader */
+	if(handle.shader_ != this)
+		throw BadUniformParametersException{"Uniform handle was not created by this shader"};
+
+	auto& interned = interned_uniforms_[handle.index_];
+	if constexpr(Store) {
+		static_assert(std::is_same_v<T, glm::mat4>, "Only a glm::mat4 may be stored");
+		interned.stored = value;
+	}
+
+	upload_uniform(program_, interned.location, value);
 }
 
 template <bool Store, typename... Args>
@@ -147,7 +180,7 @@ void Shader::upload_to_all(std::string const& name, Args&&... args) {
 
 
 template <typename... Args>
-void Shader::upload_uniform(GLint location, Args&&... args) {
+void Shader::upload_uniform(GLuint program, GLint location, Args&&... args) {
 	static_assert(0 < sizeof...(args) && sizeof...(args) < 5, "Function must be given 1 to 4 parameters");
 	static_assert(all_same_v<Args...>, "All parameters must be of the same type");
 	static_assert((!std::is_pointer_v<std::remove_const_t<Args>> && ...), "Pointers are not supported. If using glm, pass the entire object rather than calling glm::value_ptr");
@@ -170,31 +203,31 @@ void Shader::upload_uniform(GLint location, Args&&... args) {
 	if constexpr (std::is_fundamental_v<first_unqualified_t>) {
 		/* GLfloat uniforms */
 		if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::Float, dim_t::_1))
-			glUniform1f(location, std::forward<Args>(args)...);
+			glProgramUniform1f(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Float, dim_t::_2))
-			glUniform2f(location, std::forward<Args>(args)...);
+			glProgramUniform2f(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Float, dim_t::_3))
-			glUniform3f(location, std::forward<Args>(args)...);
+			glProgramUniform3f(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Float, dim_t::_4))
-			glUniform4f(location, std::forward<Args>(args)...);
+			glProgramUniform4f(program, location, std::forward<Args>(args)...);
 		/* GLint uniforms */
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::Int, dim_t::_1))
-			glUniform1i(location, std::forward<Args>(args)...);
+			glProgramUniform1i(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Int, dim_t::_2))
-			glUniform2i(location, std::forward<Args>(args)...);
-		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Int, dim_t::_3))
-			glUniform3i(location, std::forward<Args>(args)...);
+			glProgramUniform2i(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Int, dim_t::_3))
-			glUniform4i(location, std::forward<Args>(args)...);
+			glProgramUniform3i(program, location, std::forward<Args>(args)...);
+		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Int, dim_t::_4))
+			glProgramUniform4i(program, location, std::forward<Args>(args)...);
 		/* GLuint uniforms */
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::Uint, dim_t::_1))
-			glUniform1ui(location, std::forward<Args>(args)...);
+			glProgramUniform1ui(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Uint, dim_t::_2))
-			glUniform2ui(location, std::forward<Args>(args)...);
+			glProgramUniform2ui(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Uint, dim_t::_3))
-			glUniform3ui(location, std::forward<Args>(args)...);
+			glProgramUniform3ui(program, location, std::forward<Args>(args)...);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::Uint, dim_t::_4))
-			glUniform4ui(location, std::forward<Args>(args)...);
+			glProgramUniform4ui(program, location, std::forward<Args>(args)...);
 	}
 	/* Args are glm types, safe to call glm::value_ptr */
 	else {
@@ -204,51 +237,51 @@ void Shader::upload_uniform(GLint location, Args&&... args) {
 
 		/* GLfloat* uniforms */
 		if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::FloatPtr, dim_t::_1)) 		/* Will currently never be true */
-			glUniform1fv(location, 1u, value_ptr);
+			glProgramUniform1fv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::FloatPtr, dim_t::_2))
-			glUniform2fv(location, 1u, value_ptr);
+			glProgramUniform2fv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::FloatPtr, dim_t::_3))
-			glUniform3fv(location, 1u, value_ptr);
+			glProgramUniform3fv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::FloatPtr, dim_t::_4))
-			glUniform4fv(location, 1u, value_ptr);
+			glProgramUniform4fv(program, location, 1u, value_ptr);
 		/* GLint* uniforms */
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::IntPtr, dim_t::_1)) 		/* Will currently never be true */
-			glUniform1iv(location, 1u, value_ptr);
+			glProgramUniform1iv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::IntPtr, dim_t::_2))
-			glUniform2iv(location, 1u, value_ptr);
+			glProgramUniform2iv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::IntPtr, dim_t::_3))
-			glUniform3iv(location, 1u, value_ptr);
+			glProgramUniform3iv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::IntPtr, dim_t::_4))
-			glUniform4iv(location, 1u, value_ptr);
+			glProgramUniform4iv(program, location, 1u, value_ptr);
 		/* GLuint* uniforms */
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_0th, decay_t::UintPtr, dim_t::_1))		/* Will currently never be true */
-			glUniform1uiv(location, 1u, value_ptr);
+			glProgramUniform1uiv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::UintPtr, dim_t::_2))
-			glUniform2uiv(location, 1u, value_ptr);
+			glProgramUniform2uiv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::UintPtr, dim_t::_3))
-			glUniform3uiv(location, 1u, value_ptr);
+			glProgramUniform3uiv(program, location, 1u, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_1st, decay_t::UintPtr, dim_t::_4))
-			glUniform4uiv(location, 1u, value_ptr);
+			glProgramUniform4uiv(program, location, 1u, value_ptr);
 		/* nxn matrix uniforms */ 
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_2))
-			glUniformMatrix2fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix2fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_3))
-			glUniformMatrix3fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix3fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_4))
-			glUniformMatrix4fv(location, 1u, GL_FALSE, value_ptr);	
+			glProgramUniformMatrix4fv(program, location, 1u, GL_FALSE, value_ptr);	
 		/* nxm matrix uniforms */
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_2x3))
-			glUniformMatrix2x3fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix2x3fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_3x2))
-			glUniformMatrix3x2fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix3x2fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_2x4))
-			glUniformMatrix2x4fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix2x4fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_4x2))
-			glUniformMatrix4x2fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix4x2fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_3x4))
-			glUniformMatrix3x4fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix3x4fv(program, location, 1u, GL_FALSE, value_ptr);
 		else if constexpr (bind(order, decay, dim) == bind(order_t::_2nd, decay_t::FloatPtr, dim_t::_4x3))
-			glUniformMatrix4x3fv(location, 1u, GL_FALSE, value_ptr);
+			glProgramUniformMatrix4x3fv(program, location, 1u, GL_FALSE, value_ptr);
 		else
 			throw BadUniformParametersException{"Parameters do not match any known uniform"};
 	}
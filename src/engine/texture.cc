@@ -31,6 +31,29 @@ Texture::Texture(unsigned char* data, std::size_t width, std::size_t height) : w
     init(data);
 }
 
+Texture::Texture(float const* data, std::size_t width, std::size_t height) : width_{width}, height_{height} {
+    glGenTextures(1, &id_);
+    glBindTexture(GL_TEXTURE_2D, id_);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_R32F,
+                 width_,
+                 height_,
+                 0,
+                 GL_RED,
+                 GL_FLOAT,
+                 data);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 Texture::~Texture() {
     glDeleteTextures(1, &id_);
 }
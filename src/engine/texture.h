@@ -12,6 +12,8 @@ class Texture {
         Texture(GLuint tex_id);
         Texture(std::string const& path);
         Texture(unsigned char* data, std::size_t width, std::size_t height);
+        /* Single channel, 32-bit float texture clamped to the edges, e.g. a heightmap */
+        Texture(float const* data, std::size_t width, std::size_t height);
         ~Texture();
 
         static void bind(GLuint id, std::size_t unit = 0u);
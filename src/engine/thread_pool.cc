@@ -0,0 +1,114 @@
+#include "cpu_profiler.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+ThreadPool::ThreadPool() : ThreadPool{default_workers()} { }
+
+ThreadPool::ThreadPool(std::size_t workers) {
+	#ifndef RESTRICT_THREAD_USAGE
+	workers_.reserve(workers);
+	for(auto i = 0u; i < workers; i++)
+		workers_.emplace_back(&ThreadPool::work, this);
+	#else
+	static_cast<void>(workers);
+	#endif
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock{tasks_mutex_};
+		halt_execution_ = true;
+	}
+	tasks_cv_.notify_all();
+
+	for(auto& worker : workers_)
+		worker.join();
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::function<void(std::size_t, std::size_t)> const& func) {
+	if(!count)
+		return;
+
+	std::size_t const bands = std::min(count, concurrency());
+	if(bands == 1u) {
+		func(0u, count);
+		return;
+	}
+
+	auto band_begin = [count, bands](std::size_t band) {
+		return band * count / bands;
+	};
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(bands - 1u);
+	{
+		std::lock_guard<std::mutex> lock{tasks_mutex_};
+		for(auto band = 1u; band < bands; band++) {
+			std::packaged_task<void()> task{[&func, begin = band_begin(band), end = band_begin(band + 1u)]() {
+				func(begin, end);
+			}};
+			futures.push_back(task.get_future());
+			tasks_.push(std::move(task));
+		}
+	}
+	tasks_cv_.notify_all();
+
+	/* The first band is handled by the calling thread. Every future must be waited on before
+	 * returning, as the tasks refer to func */
+	std::exception_ptr exception{};
+	try {
+		func(band_begin(0u), band_begin(1u));
+	}
+	catch(...) {
+		exception = std::current_exception();
+	}
+
+	for(auto& future : futures) {
+		try {
+			future.get();
+		}
+		catch(...) {
+			if(!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	if(exception)
+		std::rethrow_exception(exception);
+}
+
+std::size_t ThreadPool::concurrency() const noexcept {
+	return workers_.size() + 1u;
+}
+
+ThreadPool& ThreadPool::instance() {
+	static ThreadPool pool{};
+	return pool;
+}
+
+void ThreadPool::work() {
+	PROFILE_THREAD("worker");
+	while(true) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock{tasks_mutex_};
+			tasks_cv_.wait(lock, [this]() {
+				return halt_execution_ || !tasks_.empty();
+			});
+
+			if(tasks_.empty())
+				return;
+
+			task = std::move(tasks_.front());
+			tasks_.pop();
+		}
+		task();
+	}
+}
+
+std::size_t ThreadPool::default_workers() noexcept {
+	unsigned const hardware_threads = std::thread::hardware_concurrency();
+	return hardware_threads > 1u ? hardware_threads - 1u : 0u;
+}
@@ -0,0 +1,47 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/* Fixed size pool of worker threads. The calling thread takes part in the work submitted through
+ * parallel_for, so the pool holds one thread less than the available hardware concurrency.
+ * If RESTRICT_THREAD_USAGE is defined, no workers are spawned and all work is done on the
+ * calling thread */
+class ThreadPool {
+	public:
+		ThreadPool();
+		explicit ThreadPool(std::size_t workers);
+		~ThreadPool();
+
+		ThreadPool(ThreadPool const&) = delete;
+		ThreadPool& operator=(ThreadPool const&) = delete;
+
+		/* Splits [0, count) into contiguous bands and calls func(begin, end) once per band, blocking
+		 * until every band is done. Exceptions thrown by func are rethrown on the calling thread */
+		void parallel_for(std::size_t count, std::function<void(std::size_t, std::size_t)> const& func);
+
+		/* Number of threads taking part in parallel_for, including the calling thread */
+		std::size_t concurrency() const noexcept;
+
+		static ThreadPool& instance();
+	private:
+		std::vector<std::thread> workers_{};
+		std::queue<std::packaged_task<void()>> tasks_{};
+		std::mutex tasks_mutex_{};
+		std::condition_variable tasks_cv_{};
+		bool halt_execution_{false};
+
+		void work();
+
+		static std::size_t default_workers() noexcept;
+};
+
+#endif
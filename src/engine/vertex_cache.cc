@@ -0,0 +1,143 @@
+#include "vertex_cache.h"
+#include "cpu_profiler.h"
+#include "logger.h"
+#include <atomic>
+#include <limits>
+
+namespace vertex_cache {
+	std::atomic<bool> enabled_{true};
+
+	std::vector<GLuint> tipsify(std::vector<GLuint> const& indices, std::size_t vertex_count, std::size_t cache_size);
+}
+
+double vertex_cache::acmr(GLuint const* indices, std::size_t size, std::size_t vertex_count, std::size_t cache_size) {
+	std::size_t const triangles = size / 3u;
+	if(!triangles)
+		return 0.0;
+
+	/* A vertex is in the FIFO cache if fewer than cache_size misses occurred since it was inserted */
+	std::size_t constexpr NEVER = std::numeric_limits<std::size_t>::max();
+	std::vector<std::size_t> inserted(vertex_count, NEVER);
+	std::size_t misses = 0u;
+	for(auto i = 0u; i < 3u * triangles; i++) {
+		auto& stamp = inserted[indices[i]];
+		if(stamp == NEVER || misses - stamp >= cache_size)
+			stamp = misses++;
+	}
+
+	return static_cast<double>(misses) / static_cast<double>(triangles);
+}
+
+vertex_cache::Statistics vertex_cache::optimize(std::vector<GLuint>& indices, std::size_t vertex_count, std::size_t cache_size) {
+	PROFILE_ZONE("vertex_cache_optimize");
+	double const before = acmr(indices.data(), indices.size(), vertex_count, cache_size);
+	if(!enabled())
+		return { before, before };
+
+	indices = tipsify(indices, vertex_count, cache_size);
+
+	double const after = acmr(indices.data(), indices.size(), vertex_count, cache_size);
+	LOG("Reordered ", indices.size() / 3u, " triangles for the vertex cache, ACMR ", before, " -> ", after);
+	return { before, after };
+}
+
+void vertex_cache::set_enabled(bool enabled) noexcept {
+	enabled_.store(enabled);
+}
+
+bool vertex_cache::enabled() noexcept {
+	return enabled_.load();
+}
+
+std::vector<GLuint> vertex_cache::tipsify(std::vector<GLuint> const& indices, std::size_t vertex_count, std::size_t cache_size) {
+	std::size_t const triangles = indices.size() / 3u;
+
+	/* Triangles using each vertex, stored contiguously per vertex */
+	std::vector<std::size_t> live(vertex_count, 0u);
+	for(auto i = 0u; i < 3u * triangles; i++)
+		live[indices[i]]++;
+
+	std::vector<std::size_t> offsets(vertex_count + 1u, 0u);
+	for(auto v = 0u; v < vertex_count; v++)
+		offsets[v + 1u] = offsets[v] + live[v];
+
+	std::vector<std::size_t> adjacency(offsets.back());
+	{
+		std::vector<std::size_t> fill{std::begin(offsets), std::end(offsets) - 1};
+		for(auto i = 0u; i < 3u * triangles; i++)
+			adjacency[fill[indices[i]]++] = i / 3u;
+	}
+
+	std::vector<std::size_t> timestamps(vertex_count, 0u);
+	std::vector<bool> emitted(triangles, false);
+	std::vector<GLuint> dead_ends;
+	std::vector<GLuint> candidates;
+	std::vector<GLuint> result;
+	result.reserve(3u * triangles);
+
+	std::size_t time = cache_size + 1u;
+	std::size_t cursor = 0u;
+	long fanning = triangles ? 0 : -1;
+
+	/* Next vertex with live triangles from the dead-end stack, then in input order, -1 once done */
+	auto skip_dead_end = [&]() -> long {
+		while(!dead_ends.empty()) {
+			GLuint const v = dead_ends.back();
+			dead_ends.pop_back();
+			if(live[v])
+				return static_cast<long>(v);
+		}
+
+		for(; cursor < vertex_count; cursor++) {
+			if(live[cursor])
+				return static_cast<long>(cursor++);
+		}
+
+		return -1;
+	};
+
+	while(fanning >= 0) {
+		auto const f = static_cast<std::size_t>(fanning);
+		candidates.clear();
+
+		for(auto a = offsets[f]; a < offsets[f + 1u]; a++) {
+			auto const t = adjacency[a];
+			if(emitted[t])
+				continue;
+
+			for(auto corner = 0u; corner < 3u; corner++) {
+				GLuint const v = indices[3u * t + corner];
+				result.push_back(v);
+				dead_ends.push_back(v);
+				candidates.push_back(v);
+				live[v]--;
+
+				if(time - timestamps[v] > cache_size)
+					timestamps[v] = time++;
+			}
+			emitted[t] = true;
+		}
+
+		/* Prefer the candidate that stays in the cache longest while its remaining triangles are emitted */
+		fanning = -1;
+		long priority = -1;
+		for(auto v : candidates) {
+			if(!live[v])
+				continue;
+
+			long p = 0;
+			if(time - timestamps[v] + 2u * live[v] <= cache_size)
+				p = static_cast<long>(time - timestamps[v]);
+
+			if(p > priority) {
+				priority = p;
+				fanning = static_cast<long>(v);
+			}
+		}
+
+		if(fanning < 0)
+			fanning = skip_dead_end();
+	}
+
+	return result;
+}
@@ -0,0 +1,36 @@
+#ifndef VERTEX_CACHE_H
+#define VERTEX_CACHE_H
+
+#pragma once
+#include <cstddef>
+#include <GL/glew.h>
+#include <vector>
+
+/* Post-transform vertex cache optimization of indexed triangle lists. Triangles are reordered with
+ * Tipsify (Sander, Nehab and Barczak, Fast Triangle Reordering for Vertex Locality and Reduced Overdraw),
+ * which runs in linear time, keeping the winding of every triangle.
+ *
+ * Efficiency is measured as the average cache miss ratio (ACMR), the number of vertex shader invocations
+ * per triangle with a FIFO cache of CACHE_SIZE entries. It lies between roughly 0.5 for a regular grid and
+ * 3 when no vertex is reused */
+namespace vertex_cache {
+	/* Smaller than the caches of current hardware, an order that does well here does as well on larger caches */
+	std::size_t constexpr CACHE_SIZE = 16u;
+
+	struct Statistics {
+		double acmr_before;
+		double acmr_after;
+	};
+
+	double acmr(GLuint const* indices, std::size_t size, std::size_t vertex_count, std::size_t cache_size = CACHE_SIZE);
+
+	/* Reorders the triangles in indices, all of which must be less than vertex_count. Leaves indices
+	 * unchanged and reports the same ACMR before and after if optimization is disabled */
+	Statistics optimize(std::vector<GLuint>& indices, std::size_t vertex_count, std::size_t cache_size = CACHE_SIZE);
+
+	/* Optimization is enabled by default */
+	void set_enabled(bool enabled) noexcept;
+	bool enabled() noexcept;
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include "vertex_layout.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+	/* Octahedral mapping around the y-axis, which terrain normals are closest to */
+	glm::vec2 octahedral_encode(glm::vec3 normal) noexcept {
+		normal = normal / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+		glm::vec2 encoded{normal.x, normal.z};
+
+		if(normal.y < 0.f) {
+			encoded = glm::vec2{(1.f - std::abs(encoded.y)) * (encoded.x < 0.f ? -1.f : 1.f),
+								(1.f - std::abs(encoded.x)) * (encoded.y < 0.f ? -1.f : 1.f)};
+		}
+
+		return encoded;
+	}
+
+	glm::vec3 octahedral_decode(glm::vec2 encoded) noexcept {
+		glm::vec3 normal{encoded.x, 1.f - std::abs(encoded.x) - std::abs(encoded.y), encoded.y};
+
+		if(normal.y < 0.f) {
+			normal.x = (1.f - std::abs(encoded.y)) * (encoded.x < 0.f ? -1.f : 1.f);
+			normal.z = (1.f - std::abs(encoded.x)) * (encoded.y < 0.f ? -1.f : 1.f);
+		}
+
+		return glm::normalize(normal);
+	}
+
+	/* Inverse of the conversion of normalized signed integers in the GL specification */
+	template <typename T>
+	T to_snorm(GLfloat value) noexcept {
+		GLfloat constexpr max = static_cast<GLfloat>(std::numeric_limits<T>::max());
+		return static_cast<T>(std::lround(std::clamp(value, -1.f, 1.f) * max));
+	}
+
+	template <typename T>
+	GLfloat from_snorm(T value) noexcept {
+		GLfloat constexpr max = static_cast<GLfloat>(std::numeric_limits<T>::max());
+		return std::max(static_cast<GLfloat>(value) / max, -1.f);
+	}
+}
+
+void float_vertex_layout::specify_attributes() {
+	auto constexpr VALUE_TYPE_SIZE = sizeof(value_type);
+
+	glEnableVertexAttribArray(0); /* Position */
+	glEnableVertexAttribArray(1); /* Normal */
+	glEnableVertexAttribArray(2); /* Texture */
+
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, 3 * VALUE_TYPE_SIZE);
+	glVertexAttribFormat(2, 2, GL_FLOAT, GL_FALSE, 6 * VALUE_TYPE_SIZE);
+
+	for(GLuint attribute = 0u; attribute < 3u; attribute++)
+		glVertexAttribBinding(attribute, 0u);
+}
+
+void terrain_vertex_layout::specify_attributes() {
+	glEnableVertexAttribArray(0); /* Height */
+	glEnableVertexAttribArray(1); /* Normal */
+
+	glVertexAttribFormat(0, 1, GL_SHORT, GL_TRUE, 0);
+	glVertexAttribFormat(1, 2, GL_BYTE, GL_TRUE, sizeof(value_type));
+
+	glVertexAttribBinding(0, 0u);
+	glVertexAttribBinding(1, 0u);
+}
+
+void terrain_vertex_layout::encode(GLfloat height, GLfloat amplitude, glm::vec3 normal, value_type* vertex) noexcept {
+	vertex[0] = to_snorm<GLshort>(height / (HEIGHT_RANGE * amplitude));
+
+	auto const encoded = octahedral_encode(normal);
+	std::array<GLbyte, 2> const bytes{to_snorm<GLbyte>(encoded.x), to_snorm<GLbyte>(encoded.y)};
+	std::memcpy(vertex + 1, bytes.data(), sizeof(value_type));
+}
+
+GLfloat terrain_vertex_layout::decode_height(value_type const* vertex, GLfloat amplitude) noexcept {
+	return from_snorm(vertex[0]) * HEIGHT_RANGE * amplitude;
+}
+
+glm::vec3 terrain_vertex_layout::decode_normal(value_type const* vertex) noexcept {
+	std::array<GLbyte, 2> bytes;
+	std::memcpy(bytes.data(), vertex + 1, sizeof(value_type));
+	return octahedral_decode(glm::vec2{from_snorm(bytes[0]), from_snorm(bytes[1])});
+}
+
+AABB terrain_vertex_layout::bounds(value_type const* vertices, std::size_t size, GLuint columns, glm::vec2 origin, glm::vec2 spacing, GLfloat amplitude) noexcept {
+	std::size_t const count = size / SIZE;
+	if(!count || !columns)
+		return {};
+
+	/* Only the heights vary within the rectangle spanned by the grid */
+	GLfloat min_height = decode_height(vertices, amplitude);
+	GLfloat max_height = min_height;
+	for(auto i = 1u; i < count; i++) {
+		GLfloat const height = decode_height(vertices + i * SIZE, amplitude);
+		min_height = std::min(min_height, height);
+		max_height = std::max(max_height, height);
+	}
+
+	std::size_t const rows = (count + columns - 1u) / columns;
+	glm::vec2 const extent = glm::vec2{static_cast<GLfloat>(std::min<std::size_t>(count, columns) - 1u), static_cast<GLfloat>(rows - 1u)} * spacing;
+
+	AABB box;
+	box.extend(glm::vec3{origin.x, min_height, origin.y});
+	box.extend(glm::vec3{origin.x + extent.x, max_height, origin.y + extent.y});
+	return box;
+}
@@ -0,0 +1,60 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#pragma once
+#include "aabb.h"
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <type_traits>
+
+/* Vertex layouts for Renderer. A layout names the type and the number of values of a vertex, and
+ * specifies the format of its attributes for vertex buffer binding 0 of the bound vertex array.
+ * T selects a layout by naming it vertex_layout, float_vertex_layout is used otherwise */
+
+/* Position, normal and texture coordinates at attribute locations 0, 1 and 2 */
+struct float_vertex_layout {
+	using value_type = GLfloat;
+	static GLuint constexpr SIZE = 8u;
+
+	static void specify_attributes();
+};
+
+/* Vertices of a regular grid, 4 bytes each. Attribute 0 holds the height as a GL_SHORT normalized over
+ * +-HEIGHT_RANGE times the terrain amplitude, and attribute 1 the normal octahedrally encoded as two
+ * normalized GL_BYTEs, packed into the second value. The position in the xz-plane and the texture
+ * coordinates follow from the index of the vertex, see assets/shaders/terrain_vertex.glsl */
+struct terrain_vertex_layout {
+	using value_type = GLshort;
+	static GLuint constexpr SIZE = 2u;
+
+	/* Smoothed noise lies within the amplitude, and Catmull-Rom weights sum to at most 1.25 in magnitude
+	 * per axis, so bicubic heights lie within 1.5625 times the sum of the octave amplitudes, 1.39. Must
+	 * match TERRAIN_HEIGHT_RANGE in terrain_vertex.glsl */
+	static GLfloat constexpr HEIGHT_RANGE = 2.25f;
+
+	static void specify_attributes();
+
+	static void encode(GLfloat height, GLfloat amplitude, glm::vec3 normal, value_type* vertex) noexcept;
+	static GLfloat decode_height(value_type const* vertex, GLfloat amplitude) noexcept;
+	static glm::vec3 decode_normal(value_type const* vertex) noexcept;
+
+	/* Box containing size values of a grid with columns vertices per row, where the first vertex is
+	 * at origin and neighbouring vertices are spacing apart */
+	static AABB bounds(value_type const* vertices, std::size_t size, GLuint columns, glm::vec2 origin, glm::vec2 spacing, GLfloat amplitude) noexcept;
+};
+
+template <typename T, typename = void>
+struct vertex_layout_of {
+	using type = float_vertex_layout;
+};
+
+template <typename T>
+struct vertex_layout_of<T, std::void_t<typename T::vertex_layout>> {
+	using type = typename T::vertex_layout;
+};
+
+template <typename T>
+using vertex_layout_of_t = typename vertex_layout_of<T>::type;
+
+#endif
@@ -3,7 +3,7 @@
 #include "window.h"
 #include <cmath>
 
-Window::Window(std::string const& name, std::size_t width, std::size_t height, float opengl_version) : Context{name, width, height, opengl_version} {
+Window::Window(std::string const& name, std::size_t width, std::size_t height, float opengl_version, bool visible) : Context{name, width, height, opengl_version, visible} {
 	if(std::signbit(opengl_version))
 		throw InvalidVersionException{"Version must be positive"};
 	init();
@@ -26,6 +26,10 @@ void Window::update() const{
 	glfwPollEvents();
 }
 
+void Window::set_vsync(bool enabled) const {
+	glfwSwapInterval(enabled ? 1 : 0);
+}
+
 void Window::init(){
 	glewExperimental = GL_TRUE;
 
@@ -34,6 +38,9 @@ void Window::init(){
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CLIP_DISTANCE0);
 
+    if(!is_visible())
+        set_vsync(false);
+
     Viewport::update();
 }
 
@@ -10,7 +10,8 @@
 
 class Window : public Context {
 	public:
-		Window(std::string const& name, std::size_t width, std::size_t height, float opengl_version = 4.5f);
+		/* A window that is not visible is headless, see Context. Its frames are not synchronized to any display */
+		Window(std::string const& name, std::size_t width, std::size_t height, float opengl_version = 4.5f, bool visible = true);
 		~Window();
 		Window(Window&&) = default;
 		Window& operator=(Window&&) = default;
@@ -18,6 +19,8 @@ class Window : public Context {
 		bool should_close() const;
 		void clear() const;
 		void update() const;
+		/* Synchronizes buffer swaps to the display's refresh rate */
+		void set_vsync(bool enabled) const;
 	
 	private:
 		void init();
@@ -0,0 +1,139 @@
+#ifndef CHUNKED_TERRAIN_H
+#define CHUNKED_TERRAIN_H
+
+#pragma once
+#include "aabb.h"
+#include "context.h"
+#include "disk_cache.h"
+#include "frustum.h"
+#include "height_generator.h"
+#include "logger.h"
+#include "shader.h"
+#include "shader_handler.h"
+#include "terrain.h"
+#include "thread_pool.h"
+#include "transform.h"
+#include "vertex_cache.h"
+#include "vertex_layout.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Asynchronous generates chunks on a streaming thread while rendering continues. Synchronous generates
+ * every missing chunk within range during update, so that the chunks rendered depend only on the camera
+ * positions, not on thread timing */
+enum class ChunkStreaming { Asynchronous, Synchronous };
+
+/* Terrain without bounds, split into square chunks of CHUNK_CELLS x CHUNK_CELLS cells. Chunks within
+ * radius chunks of the camera are generated on worker threads and uploaded from a secondary, shared
+ * context, after which update makes them available for rendering. Chunks further away than radius + 1
+ * are released. Neighbouring chunks sample the generator at the same world-space lattice points along
+ * their shared edges, so there are no cracks between them.
+ *
+ * Chunks are stored in terrain_vertex_layout and positioned by uploading their lattice origin to
+ * ufrm_grid_lattice before drawing them, which requires an automatic shader handler. The vertices of
+ * every chunk are stored in disk_cache, keyed by the chunk and the parameters of the generator.
+ *
+ * If RESTRICT_THREAD_USAGE is defined, update generates and uploads at most one chunk per call on the
+ * calling thread instead, unless streaming is Synchronous */
+template <typename ShaderPolicy = manual_shader_handler>
+class ChunkedTerrain : public Transform {
+    using HeightGen = HeightGenerator<InterpolationMethod::Bicubic>;
+    using chunk_key_t = std::pair<int, int>;
+    public:
+        ChunkedTerrain(ShaderPolicy policy = {}, GLfloat amplitude = 10.f, GLfloat spacing = .05f, int radius = 3, std::uint32_t seed = HeightGen::DEFAULT_SEED,
+                       ChunkStreaming streaming = ChunkStreaming::Asynchronous);
+        ~ChunkedTerrain();
+
+        ChunkedTerrain(ChunkedTerrain const&) = delete;
+        ChunkedTerrain& operator=(ChunkedTerrain const&) = delete;
+
+        /* Should be called once per frame on the render thread. Requests the chunks around
+         * camera_position (in world space) and activates chunks that have finished uploading.
+         * Never waits for chunks to be generated, unless streaming is Synchronous, in which case
+         * every chunk within range is active on return */
+        void update(glm::vec3 camera_position);
+        void render() const;
+
+        std::size_t active_chunks() const noexcept;
+
+        static GLuint constexpr CHUNK_CELLS = 32u;
+        static GLuint constexpr VERTEX_SIZE = terrain_vertex_layout::SIZE;
+    private:
+        struct Chunk {
+            GLuint vao;
+            GLuint vbo;
+            AABB bounds;
+        };
+
+        struct UploadedChunk {
+            chunk_key_t key;
+            GLuint vbo;
+            AABB bounds;
+            GLsync fence;
+        };
+
+        static GLuint constexpr CHUNK_SAMPLES = CHUNK_CELLS + 1u;
+        /* Differs from the reference kernel by far less than the precision of terrain_vertex_layout */
+        static HeightKernel constexpr KERNEL = HeightKernel::Vectorized;
+
+        ShaderPolicy const policy_;
+        Shader::Uniform<glm::mat4> model_uniform_{};
+        Shader::Uniform<glm::vec4> grid_uniform_{};
+        Shader::Uniform<glm::ivec3> lattice_uniform_{};
+        HeightGen generator_;
+        GLfloat const spacing_;
+        int const radius_;
+        ChunkStreaming const streaming_;
+        GLuint idx_buffer_{0u};
+        GLuint idx_size_{0u};
+
+        /* Only accessed from the render thread */
+        std::map<chunk_key_t, Chunk> chunks_{};
+        std::vector<UploadedChunk> pending_{};
+
+        /* Shared with the streaming thread, guarded by chunks_mutex_. requested_ holds every chunk
+         * that is active or being generated */
+        std::set<chunk_key_t> requested_{};
+        std::vector<UploadedChunk> uploaded_{};
+        chunk_key_t center_{};
+        bool center_valid_{false};
+        bool dirty_{false};
+        bool halt_execution_{false};
+        std::mutex chunks_mutex_{};
+        std::condition_variable chunks_cv_{};
+        std::thread streaming_thread_{};
+
+        void stream();
+        void generate_missing_chunks();
+        std::vector<chunk_key_t> missing_chunks(std::size_t max_count) const;
+        std::vector<std::vector<GLshort>> build_batch(std::vector<chunk_key_t> const& batch) const;
+
+        GLuint upload(std::vector<GLshort> const& vertices) const;
+        void activate(chunk_key_t key, GLuint vbo, AABB const& bounds);
+        void retire(chunk_key_t center);
+        chunk_key_t chunk_of(glm::vec3 world_position) const;
+
+        /* Loaded from disk_cache if present, generated and stored otherwise */
+        std::vector<GLshort> build_vertices(HeightGen& generator, chunk_key_t key) const;
+        disk_cache::Key cache_key(chunk_key_t key) const;
+        AABB chunk_bounds(chunk_key_t key, std::vector<GLshort> const& vertices) const;
+        static std::vector<GLuint> build_indices();
+        static bool in_range(chunk_key_t key, chunk_key_t center, int radius) noexcept;
+};
+
+#include "chunked_terrain.tcc"
+#endif
@@ -0,0 +1,392 @@
+template <typename ShaderPolicy>
+ChunkedTerrain<ShaderPolicy>::ChunkedTerrain(ShaderPolicy policy, GLfloat amplitude, GLfloat spacing, int radius, std::uint32_t seed, ChunkStreaming streaming)
+: Transform{}, policy_{policy}, generator_{amplitude, seed}, spacing_{spacing}, radius_{std::max(radius, 0)}, streaming_{streaming} {
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+        policy.shader()->upload_uniform("ufrm_terrain_amplitude", amplitude);
+        model_uniform_ = policy.shader()->template uniform<glm::mat4>(Shader::MODEL_UNIFORM_NAME);
+        grid_uniform_ = policy.shader()->template uniform<glm::vec4>("ufrm_grid");
+        lattice_uniform_ = policy.shader()->template uniform<glm::ivec3>("ufrm_grid_lattice");
+    }
+
+    /* Every chunk shares the same topology, and thus the same index buffer */
+    auto indices = build_indices();
+    vertex_cache::optimize(indices, CHUNK_SAMPLES * CHUNK_SAMPLES);
+    idx_size_ = static_cast<GLuint>(indices.size());
+
+    static_assert(CHUNK_SAMPLES * CHUNK_SAMPLES <= std::numeric_limits<GLushort>::max(), "Chunks cannot be indexed with GLushort");
+    std::vector<GLushort> const narrowed(std::begin(indices), std::end(indices));
+
+    glGenBuffers(1, &idx_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, idx_buffer_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLushort) * narrowed.size(), narrowed.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    #ifndef RESTRICT_THREAD_USAGE
+    if(streaming_ == ChunkStreaming::Asynchronous) {
+        LOG("Creating separate thread for terrain streaming");
+        streaming_thread_ = std::thread{&ChunkedTerrain::stream, this};
+    }
+    #endif
+}
+
+template <typename ShaderPolicy>
+ChunkedTerrain<ShaderPolicy>::~ChunkedTerrain() {
+    if(streaming_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{chunks_mutex_};
+            halt_execution_ = true;
+        }
+        chunks_cv_.notify_one();
+
+        LOG("Joining terrain streaming thread with id ", streaming_thread_.get_id());
+        streaming_thread_.join();
+    }
+
+    for(auto const& upload : uploaded_)
+        pending_.push_back(upload);
+
+    for(auto const& upload : pending_) {
+        glDeleteSync(upload.fence);
+        glDeleteBuffers(1, &upload.vbo);
+    }
+
+    for(auto const& [key, chunk] : chunks_) {
+        glDeleteVertexArrays(1, &chunk.vao);
+        glDeleteBuffers(1, &chunk.vbo);
+    }
+
+    glDeleteBuffers(1, &idx_buffer_);
+}
+
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::update(glm::vec3 camera_position) {
+    auto const center = chunk_of(camera_position);
+
+    {
+        std::lock_guard<std::mutex> lock{chunks_mutex_};
+        if(!center_valid_ || center != center_) {
+            center_ = center;
+            center_valid_ = true;
+            dirty_ = true;
+        }
+
+        pending_.insert(std::end(pending_), std::begin(uploaded_), std::end(uploaded_));
+        uploaded_.clear();
+
+        retire(center);
+    }
+
+    if(streaming_ == ChunkStreaming::Synchronous) {
+        generate_missing_chunks();
+        return;
+    }
+
+    #ifndef RESTRICT_THREAD_USAGE
+    chunks_cv_.notify_one();
+
+    /* Chunks are activated only once the commands uploading them have completed */
+    std::vector<chunk_key_t> dropped;
+    pending_.erase(
+        std::remove_if(std::begin(pending_),
+                       std::end(pending_),
+                       [this, center, &dropped](UploadedChunk const& upload) {
+            if(glClientWaitSync(upload.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+                return false;
+
+            glDeleteSync(upload.fence);
+            if(in_range(upload.key, center, radius_ + 1)) {
+                activate(upload.key, upload.vbo, upload.bounds);
+            }
+            else {
+                glDeleteBuffers(1, &upload.vbo);
+                dropped.push_back(upload.key);
+            }
+            return true;
+        }), std::end(pending_));
+
+    if(!dropped.empty()) {
+        std::lock_guard<std::mutex> lock{chunks_mutex_};
+        for(auto const& key : dropped)
+            requested_.erase(key);
+    }
+    #else
+    chunk_key_t key;
+    {
+        std::lock_guard<std::mutex> lock{chunks_mutex_};
+        auto missing = missing_chunks(1u);
+        if(missing.empty()) {
+            dirty_ = false;
+            return;
+        }
+        key = missing.front();
+        requested_.insert(key);
+    }
+
+    HeightGen generator{generator_};
+    auto const vertices = build_vertices(generator, key);
+    activate(key, upload(vertices), chunk_bounds(key, vertices));
+    #endif
+}
+
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::render() const {
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+        if(has_been_transformed()) {
+            policy_.shader()->template upload_uniform<true>(model_uniform_, model_matrix());
+            has_been_transformed() = false;
+        }
+        policy_.shader()->upload_uniform(grid_uniform_, glm::vec4{0.f, 0.f, spacing_, spacing_});
+        policy_();
+    }
+
+    auto const model = model_matrix();
+    auto const& frustum = Frustum::active();
+
+    for(auto const& [key, chunk] : chunks_) {
+        if(!frustum.intersects(chunk.bounds.transformed(model)))
+            continue;
+
+        if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+            policy_.shader()->upload_uniform(lattice_uniform_, glm::ivec3{key.first * static_cast<GLint>(CHUNK_CELLS),
+                                                                          key.second * static_cast<GLint>(CHUNK_CELLS),
+                                                                          static_cast<GLint>(CHUNK_SAMPLES)});
+        }
+
+        glBindVertexArray(chunk.vao);
+        glDrawElements(GL_TRIANGLES, idx_size_, GL_UNSIGNED_SHORT, static_cast<void*>(0));
+    }
+    glBindVertexArray(0);
+}
+
+template <typename ShaderPolicy>
+std::size_t ChunkedTerrain<ShaderPolicy>::active_chunks() const noexcept {
+    return chunks_.size();
+}
+
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::stream() {
+    Context const shared_context{"", 1u, 1u, false, true};
+    auto& pool = ThreadPool::instance();
+
+    while(true) {
+        std::vector<chunk_key_t> batch;
+        {
+            std::unique_lock<std::mutex> lock{chunks_mutex_};
+            chunks_cv_.wait(lock, [this]() {
+                return halt_execution_ || dirty_;
+            });
+
+            if(halt_execution_)
+                return;
+
+            /* Generate a limited number of chunks at a time so that a moving camera is tracked */
+            batch = missing_chunks(pool.concurrency());
+            if(batch.size() < pool.concurrency())
+                dirty_ = false;
+
+            requested_.insert(std::begin(batch), std::end(batch));
+        }
+
+        auto const vertices = build_batch(batch);
+
+        std::vector<UploadedChunk> uploads;
+        uploads.reserve(batch.size());
+        for(auto i = 0u; i < batch.size(); i++) {
+            GLuint const vbo = upload(vertices[i]);
+            auto const bounds = chunk_bounds(batch[i], vertices[i]);
+            uploads.push_back({batch[i], vbo, bounds, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+        }
+        glFlush();
+
+        std::lock_guard<std::mutex> lock{chunks_mutex_};
+        uploaded_.insert(std::end(uploaded_), std::begin(uploads), std::end(uploads));
+    }
+}
+
+/* Uploaded from the render thread, the chunks can thus be activated without waiting on a fence */
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::generate_missing_chunks() {
+    std::vector<chunk_key_t> missing;
+    {
+        std::lock_guard<std::mutex> lock{chunks_mutex_};
+        missing = missing_chunks(std::numeric_limits<std::size_t>::max());
+        requested_.insert(std::begin(missing), std::end(missing));
+        dirty_ = false;
+    }
+
+    auto const vertices = build_batch(missing);
+    for(auto i = 0u; i < missing.size(); i++)
+        activate(missing[i], upload(vertices[i]), chunk_bounds(missing[i], vertices[i]));
+}
+
+template <typename ShaderPolicy>
+std::vector<typename ChunkedTerrain<ShaderPolicy>::chunk_key_t> ChunkedTerrain<ShaderPolicy>::missing_chunks(std::size_t max_count) const {
+    std::vector<chunk_key_t> missing;
+    for(int dz = -radius_; dz <= radius_; dz++) {
+        for(int dx = -radius_; dx <= radius_; dx++) {
+            chunk_key_t const key{center_.first + dx, center_.second + dz};
+            if(requested_.find(key) == std::end(requested_))
+                missing.push_back(key);
+        }
+    }
+
+    /* Closest chunks first */
+    auto distance = [this](chunk_key_t key) {
+        return std::max(std::abs(key.first - center_.first), std::abs(key.second - center_.second));
+    };
+    std::stable_sort(std::begin(missing), std::end(missing), [&distance](chunk_key_t lhs, chunk_key_t rhs) {
+        return distance(lhs) < distance(rhs);
+    });
+
+    if(missing.size() > max_count)
+        missing.resize(max_count);
+
+    return missing;
+}
+
+template <typename ShaderPolicy>
+std::vector<std::vector<GLshort>> ChunkedTerrain<ShaderPolicy>::build_batch(std::vector<chunk_key_t> const& batch) const {
+    std::vector<std::vector<GLshort>> vertices(batch.size());
+    ThreadPool::instance().parallel_for(batch.size(), [this, &batch, &vertices](std::size_t begin, std::size_t end) {
+        HeightGen generator{generator_};
+        for(auto i = begin; i < end; i++)
+            vertices[i] = build_vertices(generator, batch[i]);
+    });
+
+    return vertices;
+}
+
+template <typename ShaderPolicy>
+GLuint ChunkedTerrain<ShaderPolicy>::upload(std::vector<GLshort> const& vertices) const {
+    GLuint vbo;
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLshort) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return vbo;
+}
+
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::activate(chunk_key_t key, GLuint vbo, AABB const& bounds) {
+    /* Vertex array objects are not shared between contexts, so they are created on the render thread */
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    glBindVertexBuffer(0, vbo, 0, VERTEX_SIZE * sizeof(terrain_vertex_layout::value_type));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_);
+    terrain_vertex_layout::specify_attributes();
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    chunks_.emplace(key, Chunk{vao, vbo, bounds});
+}
+
+template <typename ShaderPolicy>
+void ChunkedTerrain<ShaderPolicy>::retire(chunk_key_t center) {
+    for(auto it = std::begin(chunks_); it != std::end(chunks_);) {
+        if(in_range(it->first, center, radius_ + 1)) {
+            ++it;
+            continue;
+        }
+
+        glDeleteVertexArrays(1, &it->second.vao);
+        glDeleteBuffers(1, &it->second.vbo);
+        requested_.erase(it->first);
+        it = chunks_.erase(it);
+    }
+}
+
+template <typename ShaderPolicy>
+typename ChunkedTerrain<ShaderPolicy>::chunk_key_t ChunkedTerrain<ShaderPolicy>::chunk_of(glm::vec3 world_position) const {
+    glm::vec4 const local = glm::inverse(model_matrix()) * glm::vec4{world_position, 1.f};
+    GLfloat const chunk_size = static_cast<GLfloat>(CHUNK_CELLS) * spacing_;
+
+    return { static_cast<int>(std::floor(local.x / chunk_size)),
+             static_cast<int>(std::floor(local.z / chunk_size)) };
+}
+
+template <typename ShaderPolicy>
+std::vector<GLshort> ChunkedTerrain<ShaderPolicy>::build_vertices(HeightGen& generator, chunk_key_t key) const {
+    std::size_t constexpr size = VERTEX_SIZE * CHUNK_SAMPLES * CHUNK_SAMPLES;
+    auto const cache = cache_key(key);
+
+    if(auto const entry = disk_cache::load(cache); entry) {
+        if(auto const [cached, count] = entry->template section<GLshort>(0u); cached && count == size)
+            return {cached, cached + count};
+    }
+
+    int const x0 = key.first * static_cast<int>(CHUNK_CELLS);
+    int const z0 = key.second * static_cast<int>(CHUNK_CELLS);
+
+    /* Heights padded by one sample on each side for the normals along the edges */
+    GLuint constexpr stride = CHUNK_SAMPLES + 2u;
+    std::vector<GLfloat> heights(stride * stride);
+    generator.generate_rows(x0 - 1, z0 - 1, stride, stride, heights.data(), KERNEL);
+
+    /* Positions are computed in the shader from world-space lattice coordinates, making them identical
+     * along the edges shared by neighbouring chunks */
+    std::vector<GLshort> vertices(size);
+    GLshort* vertex = vertices.data();
+    for(auto i = 0u; i < CHUNK_SAMPLES; i++) {
+        for(auto j = 0u; j < CHUNK_SAMPLES; j++, vertex += VERTEX_SIZE) {
+            auto normal = Terrain<ShaderPolicy>::calculate_normal(heights, stride, j+1u, i+1u);
+            terrain_vertex_layout::encode(heights[(i+1u)*stride + j+1u], generator.amplitude(), normal, vertex);
+        }
+    }
+
+    disk_cache::store(cache, {disk_cache::section(vertices)});
+
+    return vertices;
+}
+
+template <typename ShaderPolicy>
+disk_cache::Key ChunkedTerrain<ShaderPolicy>::cache_key(chunk_key_t key) const {
+    disk_cache::Key cache{"terrain_chunk"};
+    cache.add(generator_.seed())
+         .add(generator_.amplitude())
+         .add(HeightGen::OCTAVES)
+         .add(HeightGen::ROUGHNESS)
+         .add(InterpolationMethod::Bicubic)
+         .add(KERNEL)
+         .add(terrain_vertex_layout::SIZE)
+         .add(terrain_vertex_layout::HEIGHT_RANGE)
+         .add(CHUNK_CELLS)
+         .add(key.first)
+         .add(key.second);
+    return cache;
+}
+
+template <typename ShaderPolicy>
+AABB ChunkedTerrain<ShaderPolicy>::chunk_bounds(chunk_key_t key, std::vector<GLshort> const& vertices) const {
+    glm::vec2 const origin{static_cast<GLfloat>(key.first * static_cast<int>(CHUNK_CELLS)) * spacing_,
+                           static_cast<GLfloat>(key.second * static_cast<int>(CHUNK_CELLS)) * spacing_};
+    return terrain_vertex_layout::bounds(vertices.data(), vertices.size(), CHUNK_SAMPLES, origin, glm::vec2{spacing_}, generator_.amplitude());
+}
+
+template <typename ShaderPolicy>
+std::vector<GLuint> ChunkedTerrain<ShaderPolicy>::build_indices() {
+    std::vector<GLuint> indices(3u*2u*CHUNK_CELLS*CHUNK_CELLS);
+
+    GLuint* triangle = indices.data();
+    for(auto i = 0u; i < CHUNK_CELLS; i++) {
+        for(auto j = 0u; j < CHUNK_CELLS; j++, triangle += 6) {
+            GLuint const idx = i*CHUNK_SAMPLES + j;
+            triangle[0] = idx;
+            triangle[1] = idx + 1;
+            triangle[2] = idx + CHUNK_SAMPLES;
+            triangle[3] = idx + 1;
+            triangle[4] = idx + 1 + CHUNK_SAMPLES;
+            triangle[5] = idx + CHUNK_SAMPLES;
+        }
+    }
+
+    return indices;
+}
+
+template <typename ShaderPolicy>
+bool ChunkedTerrain<ShaderPolicy>::in_range(chunk_key_t key, chunk_key_t center, int radius) noexcept {
+    return std::abs(key.first - center.first) <= radius && std::abs(key.second - center.second) <= radius;
+}
@@ -0,0 +1,97 @@
+#ifndef HEIGHTFIELD_COMPUTE_H
+#define HEIGHTFIELD_COMPUTE_H
+
+#pragma once
+#include "cpu_profiler.h"
+#include "height_generator.h"
+#include "logger.h"
+#include "shader.h"
+#include "shader_handler.h"
+#include "terrain.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Generates heights and normals on the GPU with the same lattice hash, smoothing and interpolation as
+ * HeightGenerator, and the same normals as Terrain::calculate_normal. The shader must be built from
+ * assets/shaders/heightfield.comp. After generate, buffer() holds one vec4 per lattice point, the normal
+ * in xyz and the height in w, row by row. Requires a context supporting compute shaders.
+ *
+ * The GPU evaluates the cubic in single precision, as simd_interpolation does, and GLSL's cos is not
+ * exact, so the samples agree with reference up to TOLERANCE times the amplitude rather than bit for bit */
+template <InterpolationMethod IM = InterpolationMethod::Bicubic>
+class HeightfieldCompute {
+    using HeightGen = HeightGenerator<IM>;
+    static_assert(HeightGen::OCTAVES == 3u, "OCTAVES must match HEIGHTFIELD_OCTAVES in heightfield.glsl");
+    public:
+        HeightfieldCompute(std::shared_ptr<Shader> const& shader, float amplitude, std::uint32_t seed = HeightGen::DEFAULT_SEED);
+        ~HeightfieldCompute();
+
+        HeightfieldCompute(HeightfieldCompute const&) = delete;
+        HeightfieldCompute& operator=(HeightfieldCompute const&) = delete;
+
+        /* Dispatches the shader for the width x height lattice points starting at (x0, z0). Does not wait
+         * for the GPU, commands issued afterwards that read the buffer see the samples */
+        void generate(int x0, int z0, GLuint width, GLuint height);
+
+        /* Blocks until the last generate has finished */
+        std::vector<glm::vec4> read() const;
+
+        GLuint buffer() const noexcept;
+        float amplitude() const noexcept;
+        std::uint32_t seed() const noexcept;
+
+        /* The samples generate would compute, evaluated on the CPU. Does not require a context */
+        static std::vector<glm::vec4> reference(float amplitude, std::uint32_t seed, int x0, int z0, GLuint width, GLuint height);
+
+        /* Largest absolute difference in height and in any normal component */
+        struct Difference {
+            float height;
+            float normal;
+        };
+
+        /* Generates the region on both the GPU and the CPU and compares the samples. Blocks until the GPU
+         * has finished */
+        Difference verify(int x0, int z0, GLuint width, GLuint height);
+
+        /* Heights within TOLERANCE times the amplitude. Normals within TOLERANCE, or for Cosine within twice
+         * the height tolerance, as a normal component changes by at most half as much as either height
+         * difference it is computed from */
+        bool within_tolerance(Difference const& difference) const noexcept;
+
+        static GLuint constexpr BINDING = 0u;       /* Shader storage binding, see heightfield.comp */
+        static GLuint constexpr LOCAL_SIZE = 16u;   /* Work group size along both axes */
+        /* GLSL only guarantees cos to about 2^-11, which bounds a cosine weight to 2^-12 and an octave, two
+         * nested interpolations between smoothed noise at most twice the amplitude apart, to 2^-10 of the
+         * amplitude. The octave amplitudes sum to less than two */
+        static float constexpr TOLERANCE = IM == InterpolationMethod::Cosine ? 1.f / 512.f : 1e-5f;
+    private:
+        using octave_uniforms_t = std::array<Shader::Uniform<float>, HeightGen::OCTAVES>;
+
+        std::shared_ptr<Shader> shader_;
+        float const amplitude_;
+        std::uint32_t const seed_;
+        Shader::Uniform<glm::ivec2> origin_uniform_;
+        Shader::Uniform<glm::uvec2> size_uniform_;
+        Shader::Uniform<std::uint32_t> seed_uniform_;
+        Shader::Uniform<float> amplitude_uniform_;
+        Shader::Uniform<GLint> interpolation_uniform_;
+        octave_uniforms_t octave_frequency_uniforms_;
+        octave_uniforms_t octave_amplitude_uniforms_;
+        GLuint buffer_{0u};
+        std::size_t capacity_{0u};  /* Samples the buffer has room for */
+        std::size_t samples_{0u};   /* Samples written by the last generate */
+
+        void upload_uniforms(int x0, int z0, GLuint width, GLuint height) const;
+        static octave_uniforms_t octave_uniforms(Shader const& shader, std::string const& name);
+};
+
+#include "heightfield_compute.tcc"
+#endif
@@ -0,0 +1,139 @@
+template <InterpolationMethod IM>
+HeightfieldCompute<IM>::HeightfieldCompute(std::shared_ptr<Shader> const& shader, float amplitude, std::uint32_t seed)
+: shader_{shader}, amplitude_{amplitude}, seed_{seed},
+  origin_uniform_{shader->uniform<glm::ivec2>("ufrm_origin")},
+  size_uniform_{shader->uniform<glm::uvec2>("ufrm_size")},
+  seed_uniform_{shader->uniform<std::uint32_t>("ufrm_seed")},
+  amplitude_uniform_{shader->uniform<float>("ufrm_amplitude")},
+  interpolation_uniform_{shader->uniform<GLint>("ufrm_interpolation")},
+  octave_frequency_uniforms_{octave_uniforms(*shader, "ufrm_octave_frequencies")},
+  octave_amplitude_uniforms_{octave_uniforms(*shader, "ufrm_octave_amplitudes")} {
+    glGenBuffers(1, &buffer_);
+}
+
+template <InterpolationMethod IM>
+HeightfieldCompute<IM>::~HeightfieldCompute() {
+    glDeleteBuffers(1, &buffer_);
+}
+
+template <InterpolationMethod IM>
+void HeightfieldCompute<IM>::generate(int x0, int z0, GLuint width, GLuint height) {
+    PROFILE_ZONE("heightfield_compute");
+    samples_ = static_cast<std::size_t>(width) * height;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer_);
+    if(samples_ > capacity_) {
+        LOG("Allocating heightfield buffer for ", samples_, " samples");
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(samples_ * sizeof(glm::vec4)), nullptr, GL_DYNAMIC_COPY);
+        capacity_ = samples_;
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING, buffer_);
+
+    if(!samples_)
+        return;
+
+    upload_uniforms(x0, z0, width, height);
+
+    shader_->enable();
+    glDispatchCompute((width + LOCAL_SIZE - 1u) / LOCAL_SIZE, (height + LOCAL_SIZE - 1u) / LOCAL_SIZE, 1u);
+    Shader::disable();
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+template <InterpolationMethod IM>
+std::vector<glm::vec4> HeightfieldCompute<IM>::read() const {
+    std::vector<glm::vec4> samples(samples_);
+    if(samples.empty())
+        return samples;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(samples.size() * sizeof(glm::vec4)), samples.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return samples;
+}
+
+template <InterpolationMethod IM>
+GLuint HeightfieldCompute<IM>::buffer() const noexcept {
+    return buffer_;
+}
+
+template <InterpolationMethod IM>
+float HeightfieldCompute<IM>::amplitude() const noexcept {
+    return amplitude_;
+}
+
+template <InterpolationMethod IM>
+std::uint32_t HeightfieldCompute<IM>::seed() const noexcept {
+    return seed_;
+}
+
+template <InterpolationMethod IM>
+std::vector<glm::vec4> HeightfieldCompute<IM>::reference(float amplitude, std::uint32_t seed, int x0, int z0, GLuint width, GLuint height) {
+    /* One extra sample on each side for the normals */
+    GLuint const stride = width + 2u;
+    std::vector<GLfloat> heights(static_cast<std::size_t>(stride) * (height + 2u));
+
+    HeightGen generator{amplitude, seed};
+    generator.generate_rows(x0 - 1, z0 - 1, stride, height + 2u, heights.data());
+
+    std::vector<glm::vec4> samples;
+    samples.reserve(static_cast<std::size_t>(width) * height);
+    for(auto z = 0u; z < height; z++) {
+        for(auto x = 0u; x < width; x++) {
+            auto const normal = Terrain<manual_shader_handler>::calculate_normal(heights, stride, x + 1u, z + 1u);
+            samples.emplace_back(normal, heights[(z + 1u) * stride + x + 1u]);
+        }
+    }
+
+    return samples;
+}
+
+template <InterpolationMethod IM>
+typename HeightfieldCompute<IM>::Difference HeightfieldCompute<IM>::verify(int x0, int z0, GLuint width, GLuint height) {
+    generate(x0, z0, width, height);
+    auto const samples = read();
+    auto const expected = reference(amplitude_, seed_, x0, z0, width, height);
+
+    Difference difference{0.f, 0.f};
+    for(auto i = 0u; i < samples.size(); i++) {
+        auto const delta = glm::abs(samples[i] - expected[i]);
+        difference.height = std::max(difference.height, delta.w);
+        difference.normal = std::max({difference.normal, delta.x, delta.y, delta.z});
+    }
+
+    return difference;
+}
+
+template <InterpolationMethod IM>
+bool HeightfieldCompute<IM>::within_tolerance(Difference const& difference) const noexcept {
+    float const height_tolerance = TOLERANCE * std::abs(amplitude_);
+    float const normal_tolerance = IM == InterpolationMethod::Cosine ? 2.f * height_tolerance : TOLERANCE;
+    return difference.height <= height_tolerance && difference.normal <= normal_tolerance;
+}
+
+/* Uploaded on every call, the shader may have been reloaded in between */
+template <InterpolationMethod IM>
+void HeightfieldCompute<IM>::upload_uniforms(int x0, int z0, GLuint width, GLuint height) const {
+    shader_->upload_uniform(origin_uniform_, glm::ivec2{x0, z0});
+    shader_->upload_uniform(size_uniform_, glm::uvec2{width, height});
+    shader_->upload_uniform(seed_uniform_, seed_);
+    shader_->upload_uniform(amplitude_uniform_, amplitude_);
+    shader_->upload_uniform(interpolation_uniform_, static_cast<GLint>(IM));
+
+    for(auto i = 0u; i < HeightGen::OCTAVES; i++) {
+        shader_->upload_uniform(octave_frequency_uniforms_[i], HeightGen::frequencies()[i]);
+        shader_->upload_uniform(octave_amplitude_uniforms_[i], HeightGen::amplitudes()[i]);
+    }
+}
+
+/* One handle per element of the uniform array name */
+template <InterpolationMethod IM>
+typename HeightfieldCompute<IM>::octave_uniforms_t HeightfieldCompute<IM>::octave_uniforms(Shader const& shader, std::string const& name) {
+    octave_uniforms_t uniforms;
+    for(auto i = 0u; i < HeightGen::OCTAVES; i++)
+        uniforms[i] = shader.uniform<float>(name + "[" + std::to_string(i) + "]");
+
+    return uniforms;
+}
@@ -0,0 +1,118 @@
+#ifndef QUADTREE_TERRAIN_H
+#define QUADTREE_TERRAIN_H
+
+#pragma once
+#include "aabb.h"
+#include "disk_cache.h"
+#include "exception.h"
+#include "frustum.h"
+#include "height_generator.h"
+#include "shader.h"
+#include "shader_handler.h"
+#include "texture.h"
+#include "thread_pool.h"
+#include "transform.h"
+#include "vertex_cache.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* Terrain rendered using continuous distance-dependent level of detail (CDLOD). The heights are
+ * generated once into a heightmap texture covering heightmap_size x heightmap_size cells, centered on
+ * the origin. A quadtree over the heightmap is traversed on every update, selecting nodes whose level
+ * depends on their distance to the camera. Every selected node is drawn as an instance of the same
+ * PATCH_CELLS x PATCH_CELLS grid patch, displaced in terrain.vert by sampling the heightmap, see
+ * terrain_cdlod.glsl. ufrm_cdlod is set on every render, the shader can thus not be shared with Terrain
+ * or ChunkedTerrain. Vertices are morphed towards the grid of the next, coarser level as they approach
+ * the end of their level's range, so that there is no popping when nodes change level and no cracks
+ * between nodes of different levels. Selected nodes outside Frustum::active() are skipped when rendering.
+ *
+ * The triangle count is bounded by the number of selected nodes, which grows logarithmically with
+ * the size of the heightmap rather than quadratically */
+template <typename ShaderPolicy = manual_shader_handler>
+class QuadtreeTerrain : public Transform {
+    using HeightGen = HeightGenerator<InterpolationMethod::Bicubic>;
+    public:
+        QuadtreeTerrain(ShaderPolicy policy = {}, GLfloat amplitude = 10.f, GLfloat spacing = .05f, GLuint heightmap_size = 1024u, std::uint32_t seed = HeightGen::DEFAULT_SEED);
+        ~QuadtreeTerrain();
+
+        QuadtreeTerrain(QuadtreeTerrain const&) = delete;
+        QuadtreeTerrain& operator=(QuadtreeTerrain const&) = delete;
+
+        /* Should be called once per frame, selects the nodes to render based on camera_position (in world space) */
+        void update(glm::vec3 camera_position);
+        void render() const;
+
+        std::size_t selected_nodes() const noexcept;
+        /* Number of nodes drawn by the latest call to render */
+        std::size_t visible_nodes() const noexcept;
+
+        static GLuint constexpr PATCH_CELLS = 32u;
+        static GLuint constexpr MAX_LEVELS = 16u;
+        /* The range of a level, in multiples of the size of its nodes */
+        static GLfloat constexpr LOD_RANGE_FACTOR = 2.5f;
+        /* Fraction of a level's range at which morphing starts */
+        static GLfloat constexpr MORPH_START = .66f;
+    private:
+        /* Instance data, matches node_ in terrain.vert */
+        struct Node {
+            GLfloat x;
+            GLfloat z;
+            GLfloat size;
+            GLfloat level;
+        };
+
+        /* Attribute locations of patch_position_ and node_ in terrain.vert */
+        static GLuint constexpr PATCH_LOCATION = 2u;
+        static GLuint constexpr NODE_LOCATION = 3u;
+
+        /* Differs from the reference kernel by at most simd_interpolation::TOLERANCE times the amplitude */
+        static HeightKernel constexpr KERNEL = HeightKernel::Vectorized;
+
+        ShaderPolicy const policy_;
+        Shader::Uniform<glm::mat4> model_uniform_{};
+        Shader::Uniform<glm::vec3> lod_camera_uniform_{};
+        Shader::Uniform<GLint> cdlod_uniform_{};
+        GLfloat const spacing_;
+        GLuint const heightmap_size_;
+        GLuint const root_level_;
+        GLfloat const origin_;
+
+        /* Minimum and maximum height of every node, indexed by level and then node */
+        std::vector<std::vector<glm::vec2>> height_bounds_{};
+        Texture heightmap_;
+
+        std::vector<GLfloat> ranges_{};
+        std::vector<Node> selection_{};
+        std::vector<AABB> selection_bounds_{};
+        std::vector<Node> mutable visible_{};
+        glm::vec3 camera_local_{};
+
+        GLuint vao_{0u}, vbo_{0u}, idx_buffer_{0u}, instance_buffer_{0u};
+        GLuint idx_size_{0u};
+
+        void init_patch();
+        void init_ranges();
+        void upload_uniforms(GLfloat amplitude) const;
+
+        bool select(GLuint x, GLuint z, GLuint level);
+        void add_node(GLuint x, GLuint z, GLuint level);
+        AABB bounds(GLuint x, GLuint z, GLuint level) const;
+        GLfloat node_size(GLuint level) const noexcept;
+        GLuint nodes_per_side(GLuint level) const noexcept;
+
+        Texture generate_heightmap(GLfloat amplitude, std::uint32_t seed);
+        void compute_height_bounds(GLfloat const* heights);
+
+        static GLuint compute_root_level(GLuint heightmap_size);
+        static bool intersects_sphere(AABB const& box, glm::vec3 center, GLfloat radius) noexcept;
+};
+
+#include "quadtree_terrain.tcc"
+#endif
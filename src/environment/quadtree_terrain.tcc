@@ -0,0 +1,320 @@
+template <typename ShaderPolicy>
+QuadtreeTerrain<ShaderPolicy>::QuadtreeTerrain(ShaderPolicy policy, GLfloat amplitude, GLfloat spacing, GLuint heightmap_size, std::uint32_t seed)
+: Transform{}, policy_{policy}, spacing_{spacing}, heightmap_size_{heightmap_size},
+  root_level_{compute_root_level(heightmap_size)},
+  origin_{-static_cast<GLfloat>(heightmap_size / 2u) * spacing},
+  heightmap_{generate_heightmap(amplitude, seed)} {
+    init_ranges();
+    init_patch();
+    upload_uniforms(amplitude);
+
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+        model_uniform_ = policy_.shader()->template uniform<glm::mat4>(Shader::MODEL_UNIFORM_NAME);
+        lod_camera_uniform_ = policy_.shader()->template uniform<glm::vec3>("ufrm_lod_camera");
+        cdlod_uniform_ = policy_.shader()->template uniform<GLint>("ufrm_cdlod");
+    }
+}
+
+template <typename ShaderPolicy>
+QuadtreeTerrain<ShaderPolicy>::~QuadtreeTerrain() {
+    glDeleteVertexArrays(1, &vao_);
+    glDeleteBuffers(1, &vbo_);
+    glDeleteBuffers(1, &idx_buffer_);
+    glDeleteBuffers(1, &instance_buffer_);
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::update(glm::vec3 camera_position) {
+    camera_local_ = glm::vec3{glm::inverse(model_matrix()) * glm::vec4{camera_position, 1.f}};
+
+    selection_.clear();
+    selection_bounds_.clear();
+    select(0u, 0u, root_level_);
+
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>)
+        policy_.shader()->upload_uniform(lod_camera_uniform_, camera_local_);
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::render() const {
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+        if(has_been_transformed()) {
+            policy_.shader()->template upload_uniform<true>(model_uniform_, model_matrix());
+            has_been_transformed() = false;
+        }
+        policy_.shader()->upload_uniform(cdlod_uniform_, GLint{GL_TRUE});
+        policy_();
+    }
+
+    /* Culled here rather than in update, as e.g. reflection passes render using a different frustum */
+    auto const model = model_matrix();
+    auto const& frustum = Frustum::active();
+
+    visible_.clear();
+    for(auto i = 0u; i < selection_.size(); i++)
+        if(frustum.intersects(selection_bounds_[i].transformed(model)))
+            visible_.push_back(selection_[i]);
+
+    if(visible_.empty())
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Node) * visible_.size(), visible_.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    Texture::bind(heightmap_.id(), Texture::Unit0);
+
+    glBindVertexArray(vao_);
+    glDrawElementsInstanced(GL_TRIANGLES, idx_size_, GL_UNSIGNED_SHORT, static_cast<void*>(0), static_cast<GLsizei>(visible_.size()));
+    glBindVertexArray(0);
+}
+
+template <typename ShaderPolicy>
+std::size_t QuadtreeTerrain<ShaderPolicy>::selected_nodes() const noexcept {
+    return selection_.size();
+}
+
+template <typename ShaderPolicy>
+std::size_t QuadtreeTerrain<ShaderPolicy>::visible_nodes() const noexcept {
+    return visible_.size();
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::init_patch() {
+    GLuint constexpr samples = PATCH_CELLS + 1u;
+
+    std::vector<GLfloat> vertices(2u * samples * samples);
+    for(auto i = 0u; i < samples; i++) {
+        for(auto j = 0u; j < samples; j++) {
+            vertices[2u*(i*samples + j)]      = static_cast<GLfloat>(j) / static_cast<GLfloat>(PATCH_CELLS);
+            vertices[2u*(i*samples + j) + 1u] = static_cast<GLfloat>(i) / static_cast<GLfloat>(PATCH_CELLS);
+        }
+    }
+
+    std::vector<GLuint> indices(3u*2u*PATCH_CELLS*PATCH_CELLS);
+    GLuint* triangle = indices.data();
+    for(auto i = 0u; i < PATCH_CELLS; i++) {
+        for(auto j = 0u; j < PATCH_CELLS; j++, triangle += 6) {
+            GLuint const idx = i*samples + j;
+            triangle[0] = idx;
+            triangle[1] = idx + 1;
+            triangle[2] = idx + samples;
+            triangle[3] = idx + 1;
+            triangle[4] = idx + 1 + samples;
+            triangle[5] = idx + samples;
+        }
+    }
+    vertex_cache::optimize(indices, samples * samples);
+    idx_size_ = static_cast<GLuint>(indices.size());
+
+    static_assert(samples * samples <= std::numeric_limits<GLushort>::max(), "Patches cannot be indexed with GLushort");
+    std::vector<GLushort> const narrowed(std::begin(indices), std::end(indices));
+
+    glGenVertexArrays(1, &vao_);
+    glBindVertexArray(vao_);
+
+    glGenBuffers(1, &vbo_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(PATCH_LOCATION);
+    glVertexAttribPointer(PATCH_LOCATION, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (void*)0);
+
+    glGenBuffers(1, &instance_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+
+    glEnableVertexAttribArray(NODE_LOCATION);
+    glVertexAttribPointer(NODE_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(Node), (void*)0);
+    glVertexAttribDivisor(NODE_LOCATION, 1);
+
+    glGenBuffers(1, &idx_buffer_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * narrowed.size(), narrowed.data(), GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::init_ranges() {
+    ranges_.resize(root_level_ + 1u);
+    for(auto level = 0u; level <= root_level_; level++)
+        ranges_[level] = LOD_RANGE_FACTOR * node_size(level);
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::upload_uniforms(GLfloat amplitude) const {
+    if constexpr(std::is_same_v<ShaderPolicy, automatic_shader_handler>) {
+        auto const& shader = policy_.shader();
+        shader->upload_uniform("ufrm_terrain_amplitude", amplitude);
+        shader->upload_uniform("ufrm_heightmap_origin", glm::vec2{origin_, origin_});
+        shader->upload_uniform("ufrm_heightmap_spacing", spacing_);
+        shader->upload_uniform("ufrm_patch_cells", static_cast<GLfloat>(PATCH_CELLS));
+
+        /* A level is fully morphed into the next at the end of its range, where nodes of the next level begin */
+        for(auto level = 0u; level <= root_level_; level++) {
+            GLfloat const previous = level ? ranges_[level - 1u] : 0.f;
+            GLfloat const morph_start = previous + (ranges_[level] - previous) * MORPH_START;
+            shader->upload_uniform("ufrm_morph_ranges[" + std::to_string(level) + "]", glm::vec2{morph_start, ranges_[level]});
+        }
+    }
+    else {
+        static_cast<void>(amplitude);
+    }
+}
+
+template <typename ShaderPolicy>
+bool QuadtreeTerrain<ShaderPolicy>::select(GLuint x, GLuint z, GLuint level) {
+    auto const box = bounds(x, z, level);
+
+    /* The root is always selected so that the entire heightmap is covered */
+    if(level != root_level_ && !intersects_sphere(box, camera_local_, ranges_[level]))
+        return false;
+
+    if(level == 0u || !intersects_sphere(box, camera_local_, ranges_[level - 1u])) {
+        add_node(x, z, level);
+        return true;
+    }
+
+    /* Children outside the range of their level are covered at this node's level of detail. Such
+     * a child is fully morphed, as the vertices are beyond the end of the child's range */
+    for(auto dz = 0u; dz < 2u; dz++)
+        for(auto dx = 0u; dx < 2u; dx++)
+            if(!select(2u*x + dx, 2u*z + dz, level - 1u))
+                add_node(2u*x + dx, 2u*z + dz, level - 1u);
+
+    return true;
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::add_node(GLuint x, GLuint z, GLuint level) {
+    GLfloat const size = node_size(level);
+    selection_.push_back({origin_ + static_cast<GLfloat>(x) * size,
+                          origin_ + static_cast<GLfloat>(z) * size,
+                          size,
+                          static_cast<GLfloat>(level)});
+    selection_bounds_.push_back(bounds(x, z, level));
+}
+
+template <typename ShaderPolicy>
+AABB QuadtreeTerrain<ShaderPolicy>::bounds(GLuint x, GLuint z, GLuint level) const {
+    GLfloat const size = node_size(level);
+    auto const heights = height_bounds_[level][z * nodes_per_side(level) + x];
+
+    glm::vec3 const min{origin_ + static_cast<GLfloat>(x) * size, heights.x, origin_ + static_cast<GLfloat>(z) * size};
+    return { min, glm::vec3{min.x + size, heights.y, min.z + size} };
+}
+
+template <typename ShaderPolicy>
+GLfloat QuadtreeTerrain<ShaderPolicy>::node_size(GLuint level) const noexcept {
+    return static_cast<GLfloat>(PATCH_CELLS << level) * spacing_;
+}
+
+template <typename ShaderPolicy>
+GLuint QuadtreeTerrain<ShaderPolicy>::nodes_per_side(GLuint level) const noexcept {
+    return heightmap_size_ / (PATCH_CELLS << level);
+}
+
+template <typename ShaderPolicy>
+Texture QuadtreeTerrain<ShaderPolicy>::generate_heightmap(GLfloat amplitude, std::uint32_t seed) {
+    GLuint const samples = heightmap_size_ + 1u;
+    int const first = -static_cast<int>(heightmap_size_ / 2u);
+
+    std::size_t const size = static_cast<std::size_t>(samples) * samples;
+
+    HeightGen generator{amplitude, seed};
+
+    disk_cache::Key key{"heightmap"};
+    key.add(generator.seed())
+       .add(amplitude)
+       .add(HeightGen::OCTAVES)
+       .add(HeightGen::ROUGHNESS)
+       .add(InterpolationMethod::Bicubic)
+       .add(KERNEL)
+       .add(samples);
+
+    if(auto const entry = disk_cache::load(key); entry) {
+        if(auto const [heights, count] = entry->template section<GLfloat>(0u); heights && count == size) {
+            compute_height_bounds(heights);
+            return Texture{heights, samples, samples};
+        }
+    }
+
+    std::vector<GLfloat> heights(size);
+    ThreadPool::instance().parallel_for(samples, [&](std::size_t begin, std::size_t end) {
+        HeightGen band_generator{generator};
+        band_generator.generate_rows(first, first + static_cast<int>(begin), samples, end - begin, heights.data() + begin * samples, KERNEL);
+    });
+
+    disk_cache::store(key, {disk_cache::section(heights)});
+
+    compute_height_bounds(heights.data());
+
+    return Texture{heights.data(), samples, samples};
+}
+
+template <typename ShaderPolicy>
+void QuadtreeTerrain<ShaderPolicy>::compute_height_bounds(GLfloat const* heights) {
+    GLuint const samples = heightmap_size_ + 1u;
+    height_bounds_.resize(root_level_ + 1u);
+
+    /* Leaves, including the samples on their far edges */
+    GLuint const leaves = nodes_per_side(0u);
+    height_bounds_[0].resize(leaves * leaves);
+    for(auto z = 0u; z < leaves; z++) {
+        for(auto x = 0u; x < leaves; x++) {
+            GLfloat const* first = heights + z*PATCH_CELLS*samples + x*PATCH_CELLS;
+            glm::vec2 bounds{first[0], first[0]};
+
+            for(auto i = 0u; i <= PATCH_CELLS; i++) {
+                auto const [min, max] = std::minmax_element(first + i*samples, first + i*samples + PATCH_CELLS + 1u);
+                bounds.x = std::min(bounds.x, *min);
+                bounds.y = std::max(bounds.y, *max);
+            }
+            height_bounds_[0][z*leaves + x] = bounds;
+        }
+    }
+
+    for(auto level = 1u; level <= root_level_; level++) {
+        GLuint const nodes = nodes_per_side(level);
+        auto const& children = height_bounds_[level - 1u];
+        height_bounds_[level].resize(nodes * nodes);
+
+        for(auto z = 0u; z < nodes; z++) {
+            for(auto x = 0u; x < nodes; x++) {
+                glm::vec2 bounds = children[2u*z*2u*nodes + 2u*x];
+                for(auto dz = 0u; dz < 2u; dz++) {
+                    for(auto dx = 0u; dx < 2u; dx++) {
+                        auto const child = children[(2u*z + dz)*2u*nodes + 2u*x + dx];
+                        bounds.x = std::min(bounds.x, child.x);
+                        bounds.y = std::max(bounds.y, child.y);
+                    }
+                }
+                height_bounds_[level][z*nodes + x] = bounds;
+            }
+        }
+    }
+}
+
+template <typename ShaderPolicy>
+GLuint QuadtreeTerrain<ShaderPolicy>::compute_root_level(GLuint heightmap_size) {
+    if(heightmap_size < PATCH_CELLS || heightmap_size % PATCH_CELLS || (heightmap_size & (heightmap_size - 1u)))
+        throw InvalidArgumentException{"Heightmap size must be a power of two no smaller than " + std::to_string(PATCH_CELLS)};
+
+    GLuint level = 0u;
+    while((PATCH_CELLS << level) < heightmap_size)
+        level++;
+
+    if(level >= MAX_LEVELS)
+        throw InvalidArgumentException{"Heightmap size requires more than " + std::to_string(MAX_LEVELS) + " levels"};
+
+    return level;
+}
+
+template <typename ShaderPolicy>
+bool QuadtreeTerrain<ShaderPolicy>::intersects_sphere(AABB const& box, glm::vec3 center, GLfloat radius) noexcept {
+    glm::vec3 const closest = glm::clamp(center, box.min, box.max);
+    glm::vec3 const offset = center - closest;
+    return glm::dot(offset, offset) <= radius * radius;
+}
@@ -2,31 +2,63 @@
 #define TERRAIN_H
 
 #pragma once
+#include "aabb.h"
+#include "cpu_profiler.h"
+#include "disk_cache.h"
 #include "height_generator.h"
 #include "renderer.h"
+#include "shader.h"
+#include "thread_pool.h"
 #include "transform.h"
+#include "vertex_cache.h"
+#include "vertex_layout.h"
+#include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <optional>
 #include <vector>
 
+/* Vertices are stored in terrain_vertex_layout, the shader derives their positions in the xz-plane from the
+ * ufrm_grid and ufrm_grid_lattice uniforms, see assets/shaders/terrain_vertex.glsl. With an automatic
+ * shader handler these are uploaded before every draw, otherwise the caller is responsible for them */
 template <typename ShaderPolicy>
 class Terrain : public Renderer<Terrain<ShaderPolicy>, ShaderPolicy>, public Transform {
     using renderer_t = Renderer<Terrain<ShaderPolicy>, ShaderPolicy>;
     using HeightGen = HeightGenerator<InterpolationMethod::Bicubic>;
     public:
-        Terrain(ShaderPolicy policy = {}, GLfloat amplitude = 10.f, GLfloat x_len = 1.f, GLfloat dx = .5f, GLfloat z_len = 1.f, GLfloat dz = .5f);
+        using vertex_layout = terrain_vertex_layout;
+
+        Terrain(ShaderPolicy policy = {}, GLfloat amplitude = 10.f, GLfloat x_len = 1.f, GLfloat dx = .5f, GLfloat z_len = 1.f, GLfloat dz = .5f, std::uint32_t seed = HeightGen::DEFAULT_SEED);
+
+        /* Point into the cache entry if the mesh was loaded from disk */
+        GLshort const* vertices() const noexcept;
+        std::size_t vertices_size() const noexcept;
+        GLuint const* indices() const noexcept;
+        std::size_t indices_size() const noexcept;
 
-        std::vector<GLfloat> const& vertices() const;
-        std::vector<GLuint> const& indices() const;
-        
         void init(GLfloat x_len, GLfloat dx, GLfloat z_len, GLfloat dz);
+        void render_setup() const;
+        AABB bounds() const;
+
+        static glm::vec3 calculate_normal(std::vector<GLfloat> const& heights, GLuint stride, GLuint x, GLuint z);
 
     private:
+        /* Differs from the reference kernel by far less than the precision of terrain_vertex_layout */
+        static HeightKernel constexpr KERNEL = HeightKernel::Vectorized;
+
+        ShaderPolicy const policy_;
+        Shader::Uniform<glm::vec4> grid_uniform_{};
+        Shader::Uniform<glm::ivec3> lattice_uniform_{};
         HeightGen generator_;
-        std::vector<GLfloat> vertices_{};
+        glm::vec4 grid_{};      /* Offset and spacing in the xz-plane */
+        GLuint columns_{0u};
+        std::vector<GLshort> vertices_{};
         std::vector<GLuint> indices_{};
+        std::optional<disk_cache::Entry> cached_{};
 
-        glm::vec3 calculate_normal(int x, int z);
+        bool load_cached(disk_cache::Key const& key, std::size_t vertices_size, std::size_t indices_size);
+        disk_cache::Key cache_key(GLuint x_iters, GLfloat dx, GLuint z_iters, GLfloat dz) const;
 };
 
 #include "terrain.tcc"
@@ -1,13 +1,17 @@
 template <typename ShaderPolicy>
-Terrain<ShaderPolicy>::Terrain(ShaderPolicy policy, GLfloat amplitude, GLfloat x_len, GLfloat dx, GLfloat z_len, GLfloat dz) : renderer_t{policy}, generator_{amplitude} {
-    if constexpr(renderer_t::template policy_is_automatic<ShaderPolicy>(renderer_t::OVERLOAD_RESOLVER))
+Terrain<ShaderPolicy>::Terrain(ShaderPolicy policy, GLfloat amplitude, GLfloat x_len, GLfloat dx, GLfloat z_len, GLfloat dz, std::uint32_t seed) : renderer_t{policy}, policy_{policy}, generator_{amplitude, seed} {
+    if constexpr(renderer_t::policy_is_automatic(renderer_t::OVERLOAD_RESOLVER)) {
         policy.shader()->upload_uniform("ufrm_terrain_amplitude", amplitude);
+        grid_uniform_ = policy.shader()->template uniform<glm::vec4>("ufrm_grid");
+        lattice_uniform_ = policy.shader()->template uniform<glm::ivec3>("ufrm_grid_lattice");
+    }
 
     renderer_t::init(x_len, dx, z_len, dz);
 }
 
 template <typename ShaderPolicy>
 void Terrain<ShaderPolicy>::init(GLfloat x_len, GLfloat dx, GLfloat z_len, GLfloat dz) {
+	PROFILE_ZONE("terrain_init");
 	x_len = glm::clamp(x_len, 0.05f, 10.f);
 	z_len = glm::clamp(z_len, 0.05f, 10.f);
 	dx    = glm::clamp(dx, .01f, x_len);
@@ -16,75 +20,143 @@ void Terrain<ShaderPolicy>::init(GLfloat x_len, GLfloat dx, GLfloat z_len, GLflo
 	GLuint x_iters = static_cast<GLuint>(x_len / dx) + 1u;
 	GLuint z_iters = static_cast<GLuint>(z_len / dz) + 1u;
 
-	auto constexpr VERTEX_SIZE = renderer_t::VERTEX_SIZE;
-
-	vertices_.reserve(VERTEX_SIZE*x_iters*z_iters);
-	
-	{
-		GLfloat x_start = -static_cast<GLfloat>(x_len/2);
-		GLfloat x = x_start;
-		GLfloat z = -static_cast<GLfloat>(z_len/2);
-		GLfloat s ,t;
-		std::array<GLfloat, VERTEX_SIZE> vertex;
-		for(auto i = 0u; i < z_iters; i++, z += dz, x = x_start){
-			t = interpolation::linear(static_cast<GLfloat>(i)/static_cast<GLfloat>(z_iters-1));
-
-			for(auto j = 0u; j < x_iters; j++, x += dx){
-				s = interpolation::linear(static_cast<GLfloat>(j)/static_cast<GLfloat>(x_iters-1));
-                auto normal = calculate_normal(j,i);
-
-				vertex[0] = x;   /* Position */
-				vertex[1] = generator_.generate(j,i);
-				vertex[2] = z;
-				vertex[3] = normal.x; /* Normal */
-				vertex[4] = normal.y;	
-				vertex[5] = normal.z;
-				vertex[6] = s;   /* Texture */
-				vertex[7] = t;
-			
-				vertices_.insert(std::end(vertices_), std::begin(vertex), std::end(vertex));
-			}
-		} 
-	}
-
-	indices_.reserve(3*2*(x_iters-1)*(z_iters-1));
-	std::array<GLuint, 3> triangle_indices;
-	
-	auto idx = 0u;
-	for(auto i = 0u; i < z_iters-1; idx++, i++){
-		for(auto j = 0u; j < 2*(x_iters-1); j++){
-			triangle_indices[0] = idx;
-			if(j % 2){
-				triangle_indices[1] = idx + x_iters;
-				triangle_indices[2] = idx + x_iters - 1;
+	auto constexpr VERTEX_SIZE = vertex_layout::SIZE;
+	auto constexpr INDICES_PER_CELL = 3u*2u;
+
+	std::size_t const vertices_size = VERTEX_SIZE*x_iters*z_iters;
+	std::size_t const indices_size = INDICES_PER_CELL*(x_iters-1)*(z_iters-1);
+
+	GLfloat const x_start = -static_cast<GLfloat>(x_len/2);
+	GLfloat const z_start = -static_cast<GLfloat>(z_len/2);
+	grid_ = glm::vec4{x_start, z_start, dx, dz};
+	columns_ = x_iters;
+
+	auto const key = cache_key(x_iters, dx, z_iters, dz);
+	if(load_cached(key, vertices_size, indices_size))
+		return;
+
+	vertices_.resize(vertices_size);
+	indices_.resize(indices_size);
+
+	auto& pool = ThreadPool::instance();
+
+	/* Heights for the entire grid, padded by one sample on each side for the normals along the edges */
+	GLuint const stride = x_iters + 2u;
+	GLuint const padded_rows = z_iters + 2u;
+	std::vector<GLfloat> heights(stride * padded_rows);
+
+	/* Each band uses its own copy of the generator, all copies produce the same heights */
+	pool.parallel_for(padded_rows, [this, stride, &heights](std::size_t begin, std::size_t end) {
+		PROFILE_ZONE("terrain_heights");
+		HeightGen generator{generator_};
+		generator.generate_rows(-1, static_cast<int>(begin) - 1, stride, end - begin, heights.data() + begin*stride, KERNEL);
+	});
+
+	pool.parallel_for(z_iters, [&, this](std::size_t begin, std::size_t end) {
+		PROFILE_ZONE("terrain_mesh");
+		GLfloat const amplitude = generator_.amplitude();
+		for(auto i = static_cast<GLuint>(begin); i < end; i++){
+			GLshort* vertex = vertices_.data() + VERTEX_SIZE*x_iters*i;
+			for(auto j = 0u; j < x_iters; j++, vertex += VERTEX_SIZE){
+				auto normal = calculate_normal(heights, stride, j+1u, i+1u);
+				vertex_layout::encode(heights[(i+1u)*stride + j+1u], amplitude, normal, vertex);
 			}
-			else{
-				triangle_indices[1] = idx + 1;
-				triangle_indices[2] = idx + x_iters;
-                idx++;
+
+			/* Two triangles for each cell between row i and i + 1 */
+			if(i == z_iters-1)
+				continue;
+
+			GLuint* triangle = indices_.data() + INDICES_PER_CELL*(x_iters-1)*i;
+			for(auto j = 0u; j < x_iters-1; j++, triangle += INDICES_PER_CELL){
+				GLuint const idx = i*x_iters + j;
+				triangle[0] = idx;
+				triangle[1] = idx + 1;
+				triangle[2] = idx + x_iters;
+				triangle[3] = idx + 1;
+				triangle[4] = idx + 1 + x_iters;
+				triangle[5] = idx + x_iters;
 			}
-			
-			indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 		}
-	}
+	});
+
+	vertex_cache::optimize(indices_, x_iters*z_iters);
+
+	disk_cache::store(key, {disk_cache::section(vertices_), disk_cache::section(indices_)});
 }
 
 template <typename ShaderPolicy>
-std::vector<GLfloat> const& Terrain<ShaderPolicy>::vertices() const {
-    return vertices_;
+void Terrain<ShaderPolicy>::render_setup() const {
+    if constexpr(renderer_t::policy_is_automatic(renderer_t::OVERLOAD_RESOLVER)) {
+        policy_.shader()->upload_uniform(grid_uniform_, grid_);
+        policy_.shader()->upload_uniform(lattice_uniform_, glm::ivec3{0, 0, static_cast<GLint>(columns_)});
+    }
+}
+
+template <typename ShaderPolicy>
+AABB Terrain<ShaderPolicy>::bounds() const {
+    return vertex_layout::bounds(vertices(), vertices_size(), columns_, glm::vec2{grid_.x, grid_.y}, glm::vec2{grid_.z, grid_.w}, generator_.amplitude());
+}
+
+template <typename ShaderPolicy>
+GLshort const* Terrain<ShaderPolicy>::vertices() const noexcept {
+    return cached_ ? cached_->template section<GLshort>(0u).first : vertices_.data();
+}
+
+template <typename ShaderPolicy>
+std::size_t Terrain<ShaderPolicy>::vertices_size() const noexcept {
+    return cached_ ? cached_->template section<GLshort>(0u).second : vertices_.size();
+}
+
+template <typename ShaderPolicy>
+GLuint const* Terrain<ShaderPolicy>::indices() const noexcept {
+    return cached_ ? cached_->template section<GLuint>(1u).first : indices_.data();
+}
+
+template <typename ShaderPolicy>
+std::size_t Terrain<ShaderPolicy>::indices_size() const noexcept {
+    return cached_ ? cached_->template section<GLuint>(1u).second : indices_.size();
+}
+
+template <typename ShaderPolicy>
+bool Terrain<ShaderPolicy>::load_cached(disk_cache::Key const& key, std::size_t vertices_size, std::size_t indices_size) {
+    auto entry = disk_cache::load(key);
+    if(!entry || entry->sections() != 2u)
+        return false;
+
+    if(entry->template section<GLshort>(0u).second != vertices_size || entry->template section<GLuint>(1u).second != indices_size)
+        return false;
+
+    cached_ = std::move(entry);
+    vertices_.clear();
+    indices_.clear();
+    return true;
 }
 
 template <typename ShaderPolicy>
-std::vector<GLuint> const& Terrain<ShaderPolicy>::indices() const {
-    return indices_;
+disk_cache::Key Terrain<ShaderPolicy>::cache_key(GLuint x_iters, GLfloat dx, GLuint z_iters, GLfloat dz) const {
+    disk_cache::Key key{"terrain"};
+    key.add(generator_.seed())
+       .add(generator_.amplitude())
+       .add(HeightGen::OCTAVES)
+       .add(HeightGen::ROUGHNESS)
+       .add(InterpolationMethod::Bicubic)
+       .add(KERNEL)
+       .add(vertex_layout::SIZE)
+       .add(vertex_layout::HEIGHT_RANGE)
+       .add(x_iters)
+       .add(dx)
+       .add(z_iters)
+       .add(dz)
+       .add(vertex_cache::enabled());
+    return key;
 }
 
 template <typename ShaderPolicy>
-glm::vec3 Terrain<ShaderPolicy>::calculate_normal(int x, int z) {
-    float height_left  = generator_.generate(x-1, z);
-    float height_right = generator_.generate(x+1, z);
-    float height_up    = generator_.generate(x, z+1);
-    float height_down  = generator_.generate(x, z-1);
+glm::vec3 Terrain<ShaderPolicy>::calculate_normal(std::vector<GLfloat> const& heights, GLuint stride, GLuint x, GLuint z) {
+    float height_left  = heights[z*stride + x-1u];
+    float height_right = heights[z*stride + x+1u];
+    float height_up    = heights[(z+1u)*stride + x];
+    float height_down  = heights[(z-1u)*stride + x];
     glm::vec3 normal = {height_left - height_right, 
                         2.f, 
                         height_down - height_up};
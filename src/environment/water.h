@@ -3,8 +3,10 @@
 
 #pragma once
 #include "camera.h"
+#include "frame_uniforms.h"
 #include "framebuffer.h"
 #include "frametime.h"
+#include "gpu_profiler.h"
 #include "math.h"
 #include "plane.h"
 #include "shader.h"
@@ -14,10 +16,10 @@
 #include "traits.h"
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 #include <memory>
 #include <string>
-#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -36,14 +38,20 @@ class Water : public Plane<ShaderPolicy> {
               float terrain_height,
               ShaderPolicy policy = {});
 
-        template <typename SceneRenderer, typename... Shaders>
-        void pre_process(SceneRenderer renderer, Shaders const&... shaders);
+        /* Renders the reflection and refraction textures. The camera and clipping plane in frame_uniforms
+         * are set for each pass, and restored afterwards */
+        template <typename SceneRenderer>
+        void pre_process(SceneRenderer renderer);
 
         void render();
         void translate(glm::vec3 direction);
 
+        /* Data for the dudv map, does not require a context */
+        static image_t generate_map_data();
+
     private:
         std::shared_ptr<Shader> shader_;
+        Shader::Uniform<float> dudv_offset_uniform_{};
         std::shared_ptr<Camera> camera_;
         ReflFb refl_fb_;
         RefrFb refr_fb_;
@@ -54,6 +62,7 @@ class Water : public Plane<ShaderPolicy> {
         static GLfloat constexpr WAVE_SPEED{0.02f};
         static glm::vec4 const NO_CLIP;
         static float constexpr NOISE_FREQUENCY{1.f/32.f};
+        static std::uint32_t constexpr NOISE_SEED{tileable_noise::DEFAULT_SEED};
         static image_t map_data_;
     
         using plane_t::render;       /* Force private */
@@ -61,11 +70,6 @@ class Water : public Plane<ShaderPolicy> {
     
         void init();
 
-        template <typename Uniform, typename Tuple, std::size_t... Is>
-        void upload_to_shaders(std::string const& name, Uniform const& ufrm, 
-                               Tuple const& shaders, std::index_sequence<Is...>);
-
-        static image_t generate_map_data();
         Texture dudv_map();
         Texture normal_map();
 };
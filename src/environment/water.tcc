@@ -14,54 +14,48 @@ Water<ShaderPolicy>::Water(std::shared_ptr<Shader> const& shader,
 }
 
 template <typename ShaderPolicy>
-template <typename SceneRenderer, typename... Shaders>
-void Water<ShaderPolicy>::pre_process(SceneRenderer renderer, Shaders const&... shaders) {
+template <typename SceneRenderer>
+void Water<ShaderPolicy>::pre_process(SceneRenderer renderer) {
     static_assert(is_trivially_callable_v<SceneRenderer>, "SceneRenderer must be a functor");
-    static_assert((std::is_same_v<remove_cvref_t<Shaders>, std::shared_ptr<Shader>> && ...), 
-                  "Parameter pack may only contain variablers of type shared_ptr<Shader>");
 
     glEnable(GL_CLIP_DISTANCE0);
 
     dudv_offset_ += WAVE_SPEED * frametime::delta();
     dudv_offset_ = std::fmod(dudv_offset_, 1.f);
 
-    shader_->upload_uniform("ufrm_dudv_offset", dudv_offset_);
-    shader_->upload_uniform("ufrm_camera_pos", camera_->position());
+    shader_->upload_uniform(dudv_offset_uniform_, dudv_offset_);
 
     /* Reflection pass */
+    gpu_profiler::begin("water_reflection");
     refl_fb_.bind();
-    
-    upload_to_shaders("ufrm_clipping_plane",
-                      refl_clip_,
-                      std::forward_as_tuple(shaders...),
-                      std::index_sequence_for<Shaders...>{});
 
     auto const cam_pos = camera_->position();
     float const vertical_dist = 2.f * (cam_pos.y - this->position().y);
     
     camera_->invert_pitch();
     camera_->set_position(glm::vec3{cam_pos.x, cam_pos.y - vertical_dist, cam_pos.z});
+    frame_uniforms::set_clipping_plane(refl_clip_);
+    frame_uniforms::flush();
 
     renderer();
 
     camera_->set_position(cam_pos);
     camera_->invert_pitch();
+    gpu_profiler::end();
 
     /* Refraction pass */
+    gpu_profiler::begin("water_refraction");
     refr_fb_.bind();
 
-    upload_to_shaders("ufrm_clipping_plane",
-                      refr_clip_,
-                      std::forward_as_tuple(shaders...),
-                      std::index_sequence_for<Shaders...>{});
+    frame_uniforms::set_clipping_plane(refr_clip_);
+    frame_uniforms::flush();
 
     renderer();
+    gpu_profiler::end();
 
     /* In case of driver issues */
-    upload_to_shaders("ufrm_clipping_plane",
-                      NO_CLIP,
-                      std::forward_as_tuple(shaders...),
-                      std::index_sequence_for<Shaders...>{});
+    frame_uniforms::set_clipping_plane(NO_CLIP);
+    frame_uniforms::flush();
 
     glDisable(GL_CLIP_DISTANCE0);
 }
@@ -94,18 +88,13 @@ void Water<ShaderPolicy>::init() {
     shader_->upload_uniform("dudv_map", 2);
     shader_->upload_uniform("normal_map", 3);
     shader_->upload_uniform("depth_map", 4);
+    dudv_offset_uniform_ = shader_->uniform<float>("ufrm_dudv_offset");
     
     clip_height_ = this->position().y - terrain_height_;
     refr_clip_.w = clip_height_ + 1.f;
     refl_clip_.w = -clip_height_;
 }
 
-template <typename ShaderPolicy>
-template <typename Uniform, typename Tuple, std::size_t... Is>
-void Water<ShaderPolicy>::upload_to_shaders(std::string const& name, Uniform const& ufrm, Tuple const& shaders, std::index_sequence<Is...>) {
-    (std::get<Is>(shaders)->upload_uniform(name, ufrm), ...);
-}
-
 template <typename ShaderPolicy>
 typename Water<ShaderPolicy>::image_t Water<ShaderPolicy>::generate_map_data() {
     std::size_t constexpr period = 128;
@@ -117,8 +106,8 @@ typename Water<ShaderPolicy>::image_t Water<ShaderPolicy>::generate_map_data() {
             float fi = static_cast<float>(i) * NOISE_FREQUENCY;
             float fj = static_cast<float>(j) * NOISE_FREQUENCY;
 
-            data[i][j]   = static_cast<unsigned char>((tileable_noise::generate(4.f*fj, 4.f*fi, period) + 1.f) * 0.5f * 255);
-            data[i][j+1] = static_cast<unsigned char>((tileable_noise::generate(2.f*fj, 8.f*fi, period) + 1.f) * 0.5f * 255);
+            data[i][j]   = static_cast<unsigned char>((tileable_noise::generate(4.f*fj, 4.f*fi, period, NOISE_SEED) + 1.f) * 0.5f * 255);
+            data[i][j+1] = static_cast<unsigned char>((tileable_noise::generate(2.f*fj, 8.f*fi, period, NOISE_SEED) + 1.f) * 0.5f * 255);
             data[i][j+2] = 0u;
         }
     }
@@ -69,6 +69,8 @@ void Cuboid<ShaderPolicy>::init(GLfloat x_scale, GLfloat y_scale, GLfloat z_scal
 		
 		indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 	}
+
+	vertex_cache::optimize(indices_, vertices_.size() / VERTEX_SIZE);
 }
 
 template <typename ShaderPolicy>
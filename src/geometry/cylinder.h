@@ -8,6 +8,7 @@
 #include "shader_handler.h"
 #include "transform.h"
 #include "type_conversion.h"
+#include "vertex_cache.h"
 #include <array>
 #include <cmath>
 #include <GL/glew.h>
@@ -44,7 +44,7 @@ void Cylinder<ShaderPolicy>::init(GLfloat height, GLuint horizontal_segments, GL
 
 		/* Bottom edges */
 		for(auto i = 0u; i < horizontal_segments; i++) {
-			phi = 2 * PI * static_cast<GLfloat>(i) / static_cast<GLfloat>(horizontal_segments);
+			phi = 2.f * math::PI * static_cast<GLfloat>(i) / static_cast<GLfloat>(horizontal_segments);
 			interpolation::Parameters texture = interpolation::polar(phi);
 
 			vertex[enum_value(off_axes.first)] = off_axis1_scale * cos(phi);
@@ -64,7 +64,7 @@ void Cylinder<ShaderPolicy>::init(GLfloat height, GLuint horizontal_segments, GL
 		/* Middle */
 		for(auto i = 0u; i < vertical_segments + 1; i++, current_height += height_increment) {
 			for(auto j = 0u; j < horizontal_segments; j++) {
-				phi = 2 * PI * static_cast<GLfloat>(j) / static_cast<GLfloat>(horizontal_segments);
+				phi = 2.f * math::PI * static_cast<GLfloat>(j) / static_cast<GLfloat>(horizontal_segments);
 				u = cos(phi);
 				v = sin(phi);
 
@@ -83,7 +83,7 @@ void Cylinder<ShaderPolicy>::init(GLfloat height, GLuint horizontal_segments, GL
 
 		/* Top edges */
 		for(auto i = 0u; i < horizontal_segments; i++) {
-			phi = 2 * PI * static_cast<GLfloat>(i) / static_cast<GLfloat>(horizontal_segments);
+			phi = 2.f * math::PI * static_cast<GLfloat>(i) / static_cast<GLfloat>(horizontal_segments);
 			interpolation::Parameters texture = interpolation::polar(phi);
 			
 			vertex[enum_value(off_axes.first)] = off_axis1_scale * cos(phi);
@@ -161,6 +161,8 @@ void Cylinder<ShaderPolicy>::init(GLfloat height, GLuint horizontal_segments, GL
 
 		indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 	}
+
+	vertex_cache::optimize(indices_, vertices_.size() / VERTEX_SIZE);
 }
 
 template <typename ShaderPolicy>
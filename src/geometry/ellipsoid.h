@@ -7,6 +7,7 @@
 #include "renderer.h"
 #include "shader_handler.h"
 #include "transform.h"
+#include "vertex_cache.h"
 #include <array>
 #include <cmath>
 #include <GL/glew.h>
@@ -101,27 +101,21 @@ void Ellipsoid<ShaderPolicy>::init(GLuint vertical_segments, GLuint horizontal_s
 		indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 	}
 
-	auto idx = 1u;
 	for(auto i = 0u; i < vertical_segments-2; i++) {
-		for(auto j = 0u; j < 2*horizontal_segments; j++) {
-			triangle_indices[0] = idx;
-			if(j % 2){
-				triangle_indices[1] = idx + horizontal_segments;
-				triangle_indices[2] = idx + horizontal_segments - 1;
-			}
-			else {
-				triangle_indices[1] = idx + 1;
-				triangle_indices[2] = idx + horizontal_segments;
-				idx++;
-			}
-
-			/* Triangles for last quad in each horizontal belt */
-			if((triangle_indices[2] % horizontal_segments) == 1){
-				triangle_indices[2] -= horizontal_segments;
-				if((triangle_indices[0] % horizontal_segments) == 1)
-					triangle_indices[0] -= horizontal_segments;
-			}
+		GLuint const belt = 1u + i * horizontal_segments;
+		for(auto j = 0u; j < horizontal_segments; j++) {
+			/* The last quad in each horizontal belt wraps around to its first vertices */
+			GLuint const left = belt + j;
+			GLuint const right = belt + (j + 1u) % horizontal_segments;
+
+			triangle_indices[0] = left;
+			triangle_indices[1] = left + horizontal_segments;
+			triangle_indices[2] = right;
+			indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 
+			triangle_indices[0] = right;
+			triangle_indices[1] = left + horizontal_segments;
+			triangle_indices[2] = right + horizontal_segments;
 			indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 		}
 	}
@@ -138,6 +132,8 @@ void Ellipsoid<ShaderPolicy>::init(GLuint vertical_segments, GLuint horizontal_s
 
 		indices_.insert(std::end(indices_), std::begin(triangle_indices), std::end(triangle_indices));
 	}
+
+	vertex_cache::optimize(indices_, vertices_.size() / VERTEX_SIZE);
 }
 
 template <typename ShaderPolicy>
@@ -1,77 +1,366 @@
+#include "benchmark_report.h"
 #include "camera.h"
+#include "camera_path.h"
+#include "chunked_terrain.h"
+#include "cpu_profiler.h"
+#include "cuboid.h"
+#include "draw_batch.h"
 #include "ellipsoid.h"
 #include "frametime.h"
 #include "event_handler.h"
 #include "exception.h"
+#include "frame_capture.h"
+#include "frame_uniforms.h"
+#include "gpu_profiler.h"
+#include "heightfield_compute.h"
+#include "instance_buffer.h"
+#include "math.h"
+#include "quadtree_terrain.h"
+#include "run_options.h"
 #include "scene.h"
 #include "shader.h"
-#include "terrain.h"
 #include "water.h"
 #include "window.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <vector>
 
-int main() 
+int main(int argc, char* argv[])
 try {
 	unsigned constexpr width = 960, height = 540;
+    PROFILE_THREAD("render");
+
+    auto const options = RunOptions::parse(argc, argv);
 	
-    Window window{"Main", width, height};
+    Window window{"Main", width, height, 4.5f, !options.headless};
+
+    if(options.verify_heightfield) {
+        /* Not a multiple of the work group size, and partly at negative coordinates */
+        GLuint constexpr region = 257u;
+        HeightfieldCompute heightfield{std::make_shared<Shader>("assets/shaders/heightfield.comp", Shader::Type::Compute), 10.f};
 
-    std::shared_ptr<Shader> scene_shader   = std::make_shared<Shader>("assets/shaders/scene.vert", Shader::Type::Vertex,
-                                                                      "assets/shaders/scene.frag", Shader::Type::Fragment);
-    std::shared_ptr<Shader> sun_shader     = std::make_shared<Shader>("assets/shaders/sun.vert", Shader::Type::Vertex, 
-                                                                      "assets/shaders/sun.frag", Shader::Type::Fragment);
-    std::shared_ptr<Shader> terrain_shader = std::make_shared<Shader>("assets/shaders/terrain.vert", Shader::Type::Vertex, 
-                                                                      "assets/shaders/terrain.frag", Shader::Type::Fragment);
-    std::shared_ptr<Shader> water_shader   = std::make_shared<Shader>("assets/shaders/water.vert", Shader::Type::Vertex,
-                                                                      "assets/shaders/water.frag", Shader::Type::Fragment);
+        auto const difference = heightfield.verify(-128, -64, region, region);
+        O_LOG("Heightfield differs from the CPU reference by at most ", difference.height, " in height and ",
+              difference.normal, " in normals");
+
+        return heightfield.within_tolerance(difference) ? 0 : 1;
+    }
+
+    /* Submitted together so that the driver may compile them in parallel */
+    std::optional<Shader::Future> scene_future   = Shader::compile_async("assets/shaders/scene.vert", Shader::Type::Vertex,
+                                                                         "assets/shaders/scene.frag", Shader::Type::Fragment);
+    std::optional<Shader::Future> sun_future     = Shader::compile_async("assets/shaders/sun.vert", Shader::Type::Vertex, 
+                                                                         "assets/shaders/sun.frag", Shader::Type::Fragment);
+    std::optional<Shader::Future> terrain_future = Shader::compile_async("assets/shaders/terrain.vert", Shader::Type::Vertex, 
+                                                                         "assets/shaders/terrain.frag", Shader::Type::Fragment);
+    std::optional<Shader::Future> water_future   = Shader::compile_async("assets/shaders/water.vert", Shader::Type::Vertex,
+                                                                         "assets/shaders/water.frag", Shader::Type::Fragment);
+
+    /* Props are only compiled, and thus constructed, if requested, leaving the default scene unchanged */
+    std::optional<Shader::Future> rocks_future{};
+    std::optional<Shader::Future> trees_future{};
+    if(options.props) {
+        rocks_future = Shader::compile_async("assets/shaders/batched.vert", Shader::Type::Vertex,
+                                             "assets/shaders/batched.frag", Shader::Type::Fragment);
+        trees_future = Shader::compile_async("assets/shaders/instanced.vert", Shader::Type::Vertex,
+                                             "assets/shaders/batched.frag", Shader::Type::Fragment);
+    }
 
     std::shared_ptr<Camera> camera = std::make_shared<Camera>();
     EventHandler::instantiate(camera);
 
-    Ellipsoid sun{automatic_shader_handler{sun_shader}};
-    sun.translate(glm::vec3{-80.0, 40.0, 0.0});
-    sun.scale(glm::vec3{10.0, 10.0, 10.0});
-    
     float const water_height   = -10.8f;
     float const terrain_height = -10.f;
+    float const terrain_amplitude = 10.f;
 
-    Water water{water_shader, camera, terrain_height, automatic_shader_handler{water_shader}};
-    water.translate(glm::vec3{0.0, water_height, 0.0});
-    water.scale(glm::vec3{40.0, 1.0, 40.0});
-    
-    Terrain terrain{automatic_shader_handler{terrain_shader}, 10.f, 2.f, .05f, 2.f, .05f};
-    terrain.translate(glm::vec3{0.0, terrain_height, 0.0});
-    terrain.scale(glm::vec3{20.0, 1.0, 20.0});
+    /* A terrain lattice point above the water, and a hash of it from which props derive their variation */
+    struct Placement {
+        glm::vec3 position;
+        std::uint32_t hash;
+    };
+
+    /* One placement per spacing x spacing cell within extent of the origin, jittered within the cell. Both
+     * terrains sample the same generator and map lattice point (x, z) to world (x, z), so props rest on either */
+    auto scatter = [terrain_height, terrain_amplitude, water_height](std::uint32_t seed, int spacing, int extent) {
+        HeightGenerator<InterpolationMethod::Bicubic> generator{terrain_amplitude};
+        std::vector<Placement> placements;
+        for(int z = -extent; z < extent; z += spacing) {
+            for(int x = -extent; x < extent; x += spacing) {
+                auto const hash = math::hash(seed, x, z);
+                int const lattice_x = x + static_cast<int>(hash % static_cast<std::uint32_t>(spacing));
+                int const lattice_z = z + static_cast<int>((hash >> 8u) % static_cast<std::uint32_t>(spacing));
+
+                float const height = terrain_height + generator.generate(lattice_x, lattice_z);
+                if(height > water_height + .2f)
+                    placements.push_back({glm::vec3{static_cast<float>(lattice_x), height, static_cast<float>(lattice_z)}, math::hash(hash)});
+            }
+        }
+        return placements;
+    };
+
+    /* Constructed once their shaders have compiled, frames are rendered without them until then */
+    std::optional<Ellipsoid<automatic_shader_handler>> sun{};
+    std::optional<Water<automatic_shader_handler>> water{};
+    std::optional<Scene<automatic_shader_handler>> scene{};
+    /* Both share terrain.vert, only the one selected by --cdlod is constructed */
+    std::optional<ChunkedTerrain<automatic_shader_handler>> chunked_terrain{};
+    std::optional<QuadtreeTerrain<automatic_shader_handler>> cdlod_terrain{};
+    /* Static, so every rock is a draw of a single batch rather than an object of its own */
+    std::optional<DrawBatch> rocks{};
+    /* A single mesh, drawn once per instance */
+    std::optional<Ellipsoid<automatic_shader_handler>> trees{};
+    InstanceBuffer tree_instances;
+
+    /* Reproducible runs wait for every shader before the first frame */
+    auto construct_when_ready = [wait = options.reproducible()](std::optional<Shader::Future>& future, auto&& construct) {
+        if(future && (wait || future->ready())) {
+            construct(future->get());
+            future.reset();
+        }
+    };
 
-    Scene scene{automatic_shader_handler{scene_shader}, {0.1f, 0.2f, 0.4f, 0.5f}};
+    auto construct_ready_objects = [&]() {
+        construct_when_ready(sun_future, [&sun](std::shared_ptr<Shader> const& shader) {
+            sun.emplace(automatic_shader_handler{shader});
+            sun->translate(glm::vec3{-80.0, 40.0, 0.0});
+            sun->scale(glm::vec3{10.0, 10.0, 10.0});
+            frame_uniforms::set_sun_position(sun->position());
+        });
+
+        construct_when_ready(water_future, [&water, &camera, water_height, terrain_height](std::shared_ptr<Shader> const& shader) {
+            water.emplace(shader, camera, terrain_height, automatic_shader_handler{shader});
+            water->translate(glm::vec3{0.0, water_height, 0.0});
+            water->scale(glm::vec3{40.0, 1.0, 40.0});
+        });
+
+        construct_when_ready(terrain_future, [&](std::shared_ptr<Shader> const& shader) {
+            auto place = [terrain_height](Transform& terrain) {
+                terrain.translate(glm::vec3{0.0, terrain_height, 0.0});
+                terrain.scale(glm::vec3{20.0, 1.0, 20.0});
+            };
+
+            if(options.cdlod)
+                place(cdlod_terrain.emplace(automatic_shader_handler{shader}, terrain_amplitude, .05f, 1024u));
+            else
+                place(chunked_terrain.emplace(automatic_shader_handler{shader}, terrain_amplitude, .05f, 3, HeightGenerator<InterpolationMethod::Bicubic>::DEFAULT_SEED,
+                                              options.reproducible() ? ChunkStreaming::Synchronous : ChunkStreaming::Asynchronous));
+        });
+
+        construct_when_ready(rocks_future, [&rocks, &scatter](std::shared_ptr<Shader> const& shader) {
+            std::uint32_t constexpr ROCK_SEED = 0x70c4u;
+            rocks.emplace(shader);
+
+            /* Only the geometry of the prototypes is copied, along with their model matrix at the time */
+            Cuboid<> block{{}, 1.f, .6f, .8f};
+            Ellipsoid<> boulder{{}, 8u, 8u, 1.f, .7f, .9f};
+            auto add_rock = [&rocks](auto& prototype, Placement const& placement) {
+                prototype.reset_transforms();
+                prototype.translate(placement.position);
+                prototype.rotate(static_cast<float>(placement.hash % 360u), Transform::Axis::Y);
+                prototype.scale(glm::vec3{.4f + static_cast<float>(placement.hash >> 24u) / 255.f});
+                rocks->add(prototype);
+            };
+
+            for(auto const& placement : scatter(ROCK_SEED, 6, 36)) {
+                if(placement.hash & 1u)
+                    add_rock(block, placement);
+                else
+                    add_rock(boulder, placement);
+            }
+        });
+
+        construct_when_ready(trees_future, [&trees, &tree_instances, &scatter](std::shared_ptr<Shader> const& shader) {
+            std::uint32_t constexpr TREE_SEED = 0x7ee5u;
+            trees.emplace(automatic_shader_handler{shader}, 8u, 8u, .4f, 2.f, .4f);
+
+            for(auto const& placement : scatter(TREE_SEED, 9, 36)) {
+                float const scale = .6f + static_cast<float>(placement.hash >> 24u) / 425.f;
+                glm::mat4 model = glm::translate(glm::mat4{1.f}, placement.position + glm::vec3{0.f, 1.5f * scale, 0.f});
+                tree_instances.add(glm::scale(model, glm::vec3{scale}));
+            }
+        });
+
+        construct_when_ready(scene_future, [&scene](std::shared_ptr<Shader> const& shader) {
+            scene.emplace(automatic_shader_handler{shader}, Scene<automatic_shader_handler>::Color{0.1f, 0.2f, 0.4f, 0.5f});
+        });
+    };
 
-    terrain_shader->upload_uniform("ufrm_sun_position", sun.position());
-    water_shader->upload_uniform("ufrm_sun_position", sun.position());
-    
     PostProcessing post_processing;
 
+    auto render_terrain = [&chunked_terrain, &cdlod_terrain]() {
+        if(cdlod_terrain)
+            cdlod_terrain->render();
+        else if(chunked_terrain)
+            chunked_terrain->render();
+    };
+
+    auto render_props = [&rocks, &trees, &tree_instances]() {
+        if(rocks)
+            rocks->render();
+        if(trees)
+            trees->render(tree_instances);
+    };
+
     /* Render part of scene that should be reflected and refracted in the water */
-    auto render_scene = [&terrain]() {
-        terrain.render();
+    auto render_scene = [&render_terrain, &render_props]() {
+        render_terrain();
+        render_props();
     };
 
-    while(!window.should_close()){
-        window.clear();
-        frametime::update();
-        camera->update();
+    if(options.capture_directory)
+        std::filesystem::create_directories(*options.capture_directory);
+
+    /* Replayed paths advance by a fixed step every frame and chunks are generated synchronously, so that
+     * every run renders the same frames */
+    float constexpr PATH_TIMESTEP = 1.f / 60.f;
+    std::optional<CameraPath> camera_path{};
+    if(options.camera_path_file)
+        camera_path = CameraPath::load(*options.camera_path_file);
+    else if(options.benchmark_file)
+        camera_path = CameraPath::orbit(glm::vec3{0.f, terrain_height, 0.f}, 15.f, 12.f, 20.f);
+
+    std::vector<CameraPath::Keyframe> recorded_path;
+    double elapsed_seconds = 0.0;
+
+    if(options.benchmark_file)
+        window.set_vsync(false);
+
+    gpu_profiler::set_enabled(options.gpu_profile_file || options.benchmark_file);
+    if(options.cpu_trace_file)
+        cpu_profiler::set_trace_file(*options.cpu_trace_file);
+
+    std::vector<double> frame_times;
+    auto frame_start = std::chrono::steady_clock::now();
+
+    for(std::size_t frame = 0u; !window.should_close(); frame++){
+        PROFILE_ZONE("frame");
+        {
+            PROFILE_ZONE("update");
+            window.clear();
+            Shader::reload_changed();
+            construct_ready_objects();
+            frametime::update();
+            camera->update();
+            if(camera_path)
+                camera_path->apply(*camera, static_cast<float>(frame) * PATH_TIMESTEP);
+            if(cdlod_terrain)
+                cdlod_terrain->update(camera->position());
+            else if(chunked_terrain)
+                chunked_terrain->update(camera->position());
+            frame_uniforms::flush();
+        }
+
+        {
+            PROFILE_ZONE("water_pre_process");
+            if(water)
+                water->pre_process(render_scene);
+        }
+
+        {
+            PROFILE_ZONE("render_scene");
+            Shader::bind_main_framebuffer();
+            gpu_profiler::begin("terrain");
+            render_terrain();
+            gpu_profiler::end();
+
+            if(options.props) {
+                gpu_profiler::begin("props");
+                render_props();
+                gpu_profiler::end();
+            }
+
+            gpu_profiler::begin("sun");
+            if(sun)
+                sun->render();
+            gpu_profiler::end();
+
+            gpu_profiler::begin("water");
+            if(water)
+                water->render();
+            gpu_profiler::end();
+        }
+
+        {
+            PROFILE_ZONE("post_processing");
+            Shader::bind_scene_texture();
+            post_processing.perform();
+
+            gpu_profiler::begin("scene_composite");
+            if(scene)
+                scene->render();
+            gpu_profiler::end();
+        }
 
-        water.pre_process(render_scene, sun_shader, terrain_shader);
+        if(options.should_capture(frame)) {
+            PROFILE_ZONE("capture");
+            std::ostringstream name;
+            name << "frame_" << std::setw(5) << std::setfill('0') << frame << ".png";
+            auto const pixels = frame_capture::read_default_framebuffer(window.width(), window.height());
+            frame_capture::write_png(*options.capture_directory / name.str(), pixels.data(), window.width(), window.height());
+        }
 
-        Shader::bind_main_framebuffer();
-        render_scene();
-        sun.render();
-        water.render();
+        {
+            PROFILE_ZONE("swap_buffers");
+            window.update();
+            gpu_profiler::end_frame();
+        }
+
+        auto const frame_end = std::chrono::steady_clock::now();
+        frame_times.push_back(std::chrono::duration<double, std::milli>(frame_end - frame_start).count());
+        frame_start = frame_end;
+        elapsed_seconds += frame_times.back() / 1e3;
+
+        if(options.record_path_file)
+            recorded_path.push_back({static_cast<float>(elapsed_seconds), camera->position(), camera->yaw(), camera->pitch()});
+
+        if(options.benchmark_file && frame + 1u == benchmark_report::WARMUP_FRAMES)
+            gpu_profiler::reset();
+
+        if(options.is_last_frame(frame))
+            break;
+    }
+
+    if(options.timings_file)
+        frame_capture::write_timings(*options.timings_file, frame_times);
+
+    if(options.cpu_trace_file)
+        cpu_profiler::write();
+
+    if(options.record_path_file)
+        CameraPath::write(*options.record_path_file, recorded_path);
+
+    if(options.benchmark_file) {
+        auto const warmup = std::min(frame_times.size(), benchmark_report::WARMUP_FRAMES);
+        auto const statistics = benchmark_report::compute({std::begin(frame_times) + static_cast<std::ptrdiff_t>(warmup), std::end(frame_times)});
+        auto const* renderer = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
+
+        benchmark_report::write(*options.benchmark_file, statistics, gpu_profiler::pass_times(), renderer ? renderer : "unknown");
+        O_LOG(benchmark_report::summary(statistics));
+    }
+
+    if(options.gpu_profile_file) {
+        gpu_profiler::write(*options.gpu_profile_file);
+        O_LOG(gpu_profiler::summary());
+        if(gpu_profiler::dropped_results()) {
+            ERR_LOG_WARN(gpu_profiler::dropped_results(), " GPU timer results were not available in time and were dropped");
+        }
+    }
 
-        Shader::bind_scene_texture();
-        post_processing.perform();
+    /* The queries belong to the context, which is destroyed along with the window */
+    gpu_profiler::shutdown();
 
-        scene.render(); 
-        window.update();
+    if(!frame_times.empty()) {
+        LOG("Rendered ", frame_times.size(), " frames, ", 
+            std::accumulate(std::begin(frame_times), std::end(frame_times), 0.0) / static_cast<double>(frame_times.size()), " ms on average");
     }
 
 	return 0;
@@ -0,0 +1,28 @@
+#include "aabb.h"
+#include <cmath>
+
+void AABB::extend(glm::vec3 point) noexcept {
+	min = glm::min(min, point);
+	max = glm::max(max, point);
+}
+
+bool AABB::empty() const noexcept {
+	return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+AABB AABB::transformed(glm::mat4 const& matrix) const noexcept {
+	if(empty())
+		return *this;
+
+	/* Transform the center and project the half extents onto the transformed axes */
+	glm::vec3 const center = 0.5f * (min + max);
+	glm::vec3 const extent = 0.5f * (max - min);
+
+	glm::vec3 const transformed_center = glm::vec3{matrix * glm::vec4{center, 1.f}};
+	glm::vec3 transformed_extent{0.f};
+	for(auto col = 0; col < 3; col++)
+		for(auto row = 0; row < 3; row++)
+			transformed_extent[row] += std::abs(matrix[col][row]) * extent[col];
+
+	return { transformed_center - transformed_extent, transformed_center + transformed_extent };
+}
@@ -0,0 +1,37 @@
+#ifndef AABB_H
+#define AABB_H
+
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <limits>
+
+/* Axis-aligned bounding box. A default constructed box is empty, extending it by a point makes it
+ * contain exactly that point */
+struct AABB {
+	glm::vec3 min{std::numeric_limits<float>::max()};
+	glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+	void extend(glm::vec3 point) noexcept;
+	bool empty() const noexcept;
+
+	/* Smallest axis-aligned box containing this box after transformation by matrix */
+	AABB transformed(glm::mat4 const& matrix) const noexcept;
+
+	/* Box containing the positions in vertices, where a vertex is stride values wide and
+	 * its position is stored in the first three */
+	template <typename T>
+	static AABB from_vertices(T const* vertices, std::size_t size, std::size_t stride);
+};
+
+template <typename T>
+AABB AABB::from_vertices(T const* vertices, std::size_t size, std::size_t stride) {
+	AABB box;
+	for(auto i = 0u; i + 2u < size; i += stride)
+		box.extend(glm::vec3{static_cast<float>(vertices[i]), 
+		                     static_cast<float>(vertices[i + 1u]), 
+		                     static_cast<float>(vertices[i + 2u])});
+	return box;
+}
+
+#endif
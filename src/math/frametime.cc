@@ -1,5 +1,5 @@
+#include "frame_uniforms.h"
 #include "frametime.h"
-#include "shader.h"
 #include "traits.h"
 #include <cstddef>
 #include <deque>
@@ -22,7 +22,11 @@ void frametime::update() {
 	current_frame = static_cast<float>(glfwGetTime());
 	delta_time = current_frame - last_frame;
 	last_frame = current_frame;
-	Shader::upload_to_all(Shader::TIME_UNIFORM_NAME, current_frame);
+
+	frame_times.push_front(1 / delta_time);
+	frame_times.pop_back();
+
+	frame_uniforms::set_time(current_frame);
 }
 
 float frametime::delta() {
@@ -34,12 +38,7 @@ float frametime::uptime() {
 }
 
 float frametime::fps() {
-	float rate = std::accumulate(std::begin(frame_times), std::end(frame_times), 0.f) / MEAN_FRAMES;
-
-	frame_times.push_front(1 / delta_time);
-	frame_times.pop_back();
-	
-	return rate;
+	return std::accumulate(std::begin(frame_times), std::end(frame_times), 0.f) / MEAN_FRAMES;
 }
 
 
@@ -8,6 +8,7 @@ namespace frametime {
 
 	float delta();
 	float uptime();
+	/* Mean over the last MEAN_FRAMES frames */
 	float fps();
 }
 
@@ -0,0 +1,41 @@
+#include "frustum.h"
+
+Frustum::Frustum(glm::mat4 const& view_projection) {
+	/* Planes are extracted from the rows of the combined matrix, glm stores matrices column major */
+	auto row = [&view_projection](int idx) {
+		return glm::vec4{view_projection[0][idx], view_projection[1][idx], view_projection[2][idx], view_projection[3][idx]};
+	};
+
+	planes_[Left]   = row(3) + row(0);
+	planes_[Right]  = row(3) - row(0);
+	planes_[Bottom] = row(3) + row(1);
+	planes_[Top]    = row(3) - row(1);
+	planes_[Near]   = row(3) + row(2);
+	planes_[Far]    = row(3) - row(2);
+}
+
+bool Frustum::intersects(AABB const& box) const noexcept {
+	if(box.empty())
+		return false;
+
+	/* The box is outside if its corner furthest along the normal of any plane is behind it */
+	for(auto const& plane : planes_) {
+		glm::vec3 const corner{plane.x >= 0.f ? box.max.x : box.min.x,
+		                       plane.y >= 0.f ? box.max.y : box.min.y,
+		                       plane.z >= 0.f ? box.max.z : box.min.z};
+
+		if(plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.f)
+			return false;
+	}
+	return true;
+}
+
+Frustum const& Frustum::active() noexcept {
+	return active_;
+}
+
+void Frustum::set_active(Frustum const& frustum) noexcept {
+	active_ = frustum;
+}
+
+Frustum Frustum::active_{};
@@ -0,0 +1,32 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#pragma once
+#include "aabb.h"
+#include <array>
+#include <glm/glm.hpp>
+
+/* View frustum, represented by its six planes in world space. A default constructed frustum
+ * contains everything */
+class Frustum {
+	public:
+		Frustum() = default;
+		explicit Frustum(glm::mat4 const& view_projection);
+
+		/* Conservative, may report boxes just outside a corner of the frustum as intersecting */
+		bool intersects(AABB const& box) const noexcept;
+
+		/* The frustum objects are culled against when rendered */
+		static Frustum const& active() noexcept;
+		static void set_active(Frustum const& frustum) noexcept;
+
+	private:
+		enum Plane { Left, Right, Bottom, Top, Near, Far, Count };
+
+		/* Plane (a, b, c, d) contains points p with a*p.x + b*p.y + c*p.z + d >= 0 */
+		std::array<glm::vec4, Plane::Count> planes_{};
+
+		static Frustum active_;
+};
+
+#endif
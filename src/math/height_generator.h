@@ -3,36 +3,74 @@
 
 #pragma once
 #include "interpolation.h"
+#include "lattice_cache.h"
+#include "math.h"
+#include "simd_interpolation.h"
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
-#include <random>
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 enum class InterpolationMethod { Cosine, Bilinear, Bicubic };
 
+/* Reference evaluates the interpolation exactly as generate does. Vectorized uses the SIMD kernels in
+ * simd_interpolation for the bicubic method, trading bit-identical output for speed. The difference
+ * is bounded by simd_interpolation::TOLERANCE times the amplitude */
+enum class HeightKernel { Reference, Vectorized };
+
 template <InterpolationMethod IM = InterpolationMethod::Cosine> 
 class HeightGenerator {
     public:
-        HeightGenerator(float amplitude);
+        /* Generators constructed with the same amplitude and seed generate the same heights */
+        explicit HeightGenerator(float amplitude, std::uint32_t seed = DEFAULT_SEED);
+
+        /* The copy shares amplitude and seed with other but owns its own noise cache. Separate copies may
+         * therefore be used concurrently */
+        HeightGenerator(HeightGenerator const& other);
+        HeightGenerator& operator=(HeightGenerator const&) = delete;
 
         float generate(int x, int z);
 
+        float amplitude() const noexcept;
+        std::uint32_t seed() const noexcept;
+
+        /* Evaluate the rectangular region of width x height samples starting at (x0, z0), writing
+         * the height at (x0 + c, z0 + r) to out[r * width + c]. Smoothed lattice values and cubic
+         * coefficients are shared between neighbouring samples. Using the reference kernel, the output
+         * is bit-identical to calling generate for each sample */
+        void generate_rows(int x0, int z0, std::size_t width, std::size_t height, float* out, HeightKernel kernel = HeightKernel::Reference);
+
+        static std::uint32_t constexpr DEFAULT_SEED = 0x5eedu;
         static std::size_t constexpr OCTAVES = 3u;
         static float constexpr ROUGHNESS = 0.3f; 
+
+        using octave_array_t = std::array<float, OCTAVES>;
+
+        /* Frequency and weight of each octave, the same for every generator */
+        static octave_array_t const& frequencies() noexcept;
+        static octave_array_t const& amplitudes() noexcept;
     private:
+        using coefficients_t = interpolation::CubicCoefficients<float>;
+
         float const amplitude_;
-        std::mt19937 mt_;
-        std::uniform_real_distribution<float> dist_;
-        std::unordered_map<int, float> cache_{};
-        int const seed_;
+        std::uint32_t const seed_;
+        LatticeCache cache_{};
 
-        static int constexpr DISTR_MAX_MIN = 10'000;
-        static std::uniform_int_distribution<int> seed_dist_;
+        static octave_array_t const frequencies_;
+        static octave_array_t const amplitudes_;
 
         float generate_noise(int x, int z);
         float generate_smooth_noise(int x, int z);
         float interpolated_noise(float x, float z);
+
+        void generate_lattice_rows(int x_begin, std::size_t columns, int z, std::vector<float>& smoothed);
+        static void generate_vector_coefficients(std::vector<float> const& smoothed, std::size_t columns, std::size_t cells, std::vector<float>& coefficients);
+
+        static auto constexpr stencil_rows();
+        static octave_array_t compute_frequencies();
+        static octave_array_t compute_amplitudes();
 };
 
 
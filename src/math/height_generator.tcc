@@ -1,33 +1,171 @@
 
 template <InterpolationMethod IM>
-HeightGenerator<IM>::HeightGenerator(float amplitude) : amplitude_{amplitude}, mt_{std::random_device{}()}, dist_{-amplitude_, amplitude_}, seed_{seed_dist_(mt_)} { }
+HeightGenerator<IM>::HeightGenerator(float amplitude, std::uint32_t seed) : amplitude_{amplitude}, seed_{seed} { }
+
+template <InterpolationMethod IM>
+HeightGenerator<IM>::HeightGenerator(HeightGenerator const& other) : amplitude_{other.amplitude_}, seed_{other.seed_} { }
 
 template <InterpolationMethod IM>
 float HeightGenerator<IM>::generate(int x, int z) {
     float height = 0.f;
-    float divisor = std::pow(2.f, OCTAVES-1u);
     for(auto i = 0u; i < OCTAVES; i++) {
-        float frequency = std::pow(2.f, i) / divisor;
-        float amp = std::pow(ROUGHNESS, i);
-        height += interpolated_noise(static_cast<float>(x)*frequency, 
-                                     static_cast<float>(z)*frequency) * amp;
+        height += interpolated_noise(static_cast<float>(x)*frequencies_[i], 
+                                     static_cast<float>(z)*frequencies_[i]) * amplitudes_[i];
     }
 
     return height;
 }
 
+template <InterpolationMethod IM>
+float HeightGenerator<IM>::amplitude() const noexcept {
+    return amplitude_;
+}
+
+template <InterpolationMethod IM>
+std::uint32_t HeightGenerator<IM>::seed() const noexcept {
+    return seed_;
+}
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t const& HeightGenerator<IM>::frequencies() noexcept {
+    return frequencies_;
+}
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t const& HeightGenerator<IM>::amplitudes() noexcept {
+    return amplitudes_;
+}
+
+template <InterpolationMethod IM>
+void HeightGenerator<IM>::generate_rows(int x0, int z0, std::size_t width, std::size_t height, float* out, HeightKernel kernel) {
+    std::fill(out, out + width * height, 0.f);
+    if(!width || !height)
+        return;
+
+    auto constexpr rows = stencil_rows();
+    std::vector<float> smoothed;
+    std::vector<coefficients_t> coefficients;
+
+    /* Only the bicubic stencil is vectorized */
+    bool const vectorized = IM == InterpolationMethod::Bicubic && kernel == HeightKernel::Vectorized;
+    std::vector<float> vector_coefficients;
+    std::vector<float> vector_rem_x;
+    std::vector<std::int32_t> vector_cells;
+
+    for(auto i = 0u; i < OCTAVES; i++) {
+        float const frequency = frequencies_[i];
+        float const amp = amplitudes_[i];
+
+        /* Truncation is monotonic, the lattice cells of all samples in a row lie in [x_first, x_last] */
+        int const x_first = static_cast<int>(static_cast<float>(x0) * frequency);
+        int const x_last  = static_cast<int>(static_cast<float>(x0 + static_cast<int>(width) - 1) * frequency);
+
+        std::size_t const cells = static_cast<std::size_t>(x_last - x_first) + 1u;
+        /* One extra lattice column to the left and two to the right for the stencil */
+        std::size_t const columns = cells + 3u;
+
+        bool lattice_valid = false;
+        int lattice_z = 0;
+
+        /* The lattice cells along x are the same for every row */
+        if(vectorized) {
+            vector_rem_x.resize(width);
+            vector_cells.resize(width);
+            for(auto c = 0u; c < width; c++) {
+                float const x = static_cast<float>(x0 + static_cast<int>(c)) * frequency;
+                int const x_i = static_cast<int>(x);
+                vector_rem_x[c] = x - static_cast<float>(x_i);
+                vector_cells[c] = x_i - x_first;
+            }
+        }
+
+        for(auto r = 0u; r < height; r++) {
+            float const z = static_cast<float>(z0 + static_cast<int>(r)) * frequency;
+            int const z_i = static_cast<int>(z);
+            float const rem_z = z - static_cast<float>(z_i);
+
+            /* Consecutive rows mapping to the same lattice row share smoothed values and coefficients */
+            if(!lattice_valid || z_i != lattice_z) {
+                generate_lattice_rows(x_first - 1, columns, z_i, smoothed);
+
+                if constexpr(IM == InterpolationMethod::Bicubic) {
+                    if(vectorized)
+                        generate_vector_coefficients(smoothed, columns, cells, vector_coefficients);
+                    else {
+                        coefficients.resize(rows.size() * cells);
+                        for(auto k = 0u; k < rows.size(); k++) {
+                            float const* row = &smoothed[k * columns];
+                            for(auto c = 0u; c < cells; c++)
+                                coefficients[k * cells + c] = interpolation::cubic_coefficients(row[c], row[c+1], row[c+2], row[c+3]);
+                        }
+                    }
+                }
+
+                lattice_valid = true;
+                lattice_z = z_i;
+            }
+
+            float* out_row = out + r * width;
+            if(vectorized) {
+                simd_interpolation::bicubic_row(width, vector_rem_x.data(), vector_cells.data(), rem_z, 
+                                                vector_coefficients.data(), cells, amp, out_row);
+                continue;
+            }
+
+            for(auto c = 0u; c < width; c++) {
+                float const x = static_cast<float>(x0 + static_cast<int>(c)) * frequency;
+                int const x_i = static_cast<int>(x);
+                float const rem_x = x - static_cast<float>(x_i);
+
+                std::size_t const cell = static_cast<std::size_t>(x_i - x_first);
+                float noise;
+
+                if constexpr(IM == InterpolationMethod::Bicubic) {
+                    float const row0 = interpolation::cubic(rem_x, coefficients[cell]);
+                    float const row1 = interpolation::cubic(rem_x, coefficients[cells + cell]);
+                    float const row2 = interpolation::cubic(rem_x, coefficients[2u * cells + cell]);
+                    float const row3 = interpolation::cubic(rem_x, coefficients[3u * cells + cell]);
+
+                    noise = interpolation::cubic(rem_z, row0, row1, row2, row3);
+                }
+                else {
+                    /* Offset by one for the leftmost stencil column */
+                    float const p1_z1 = smoothed[cell + 1u];
+                    float const p2_z1 = smoothed[cell + 2u];
+                    float const p1_z2 = smoothed[columns + cell + 1u];
+                    float const p2_z2 = smoothed[columns + cell + 2u];
+
+                    if constexpr(IM == InterpolationMethod::Cosine) {
+                        float const z1 = interpolation::cosine(rem_x, p1_z1, p2_z1);
+                        float const z2 = interpolation::cosine(rem_x, p1_z2, p2_z2);
+
+                        noise = interpolation::cosine(rem_z, z1, z2);
+                    }
+                    else {
+                        float const z1 = interpolation::linear(rem_x, p1_z1, p2_z1);
+                        float const z2 = interpolation::linear(rem_x, p1_z2, p2_z2);
+
+                        noise = interpolation::linear(rem_z, z1, z2);
+                    }
+                }
+
+                out_row[c] += noise * amp;
+            }
+        }
+    }
+}
+
 template <InterpolationMethod IM>
 float HeightGenerator<IM>::generate_noise(int x, int z) {
-    auto hash = x + 10'000 * z;
+    float& value = cache_.at(x, z);
 
-    auto it = cache_.find(hash);
-    if(it == std::end(cache_)) {
-        mt_.seed(seed_ + x * 1993 + z * 1290);
-        it = cache_.emplace_hint(std::end(cache_), hash, dist_(mt_));
+    if(LatticeCache::is_empty(value)) {
+        /* The upper 24 bits of the hash map exactly onto floats in [-1, 1) */
+        std::uint32_t const bits = math::hash(seed_, x, z) >> 8u;
+        value = (static_cast<float>(bits) * (2.f / 16'777'216.f) - 1.f) * amplitude_;
     }
     
-    return it->second;
-
+    return value;
 }
 
 template <InterpolationMethod IM>
@@ -103,7 +241,65 @@ float HeightGenerator<IM>::interpolated_noise(float x, float z) {
 }
 
 template <InterpolationMethod IM>
-std::uniform_int_distribution<int> HeightGenerator<IM>::seed_dist_{
-    -DISTR_MAX_MIN,
-     DISTR_MAX_MIN
-};
+void HeightGenerator<IM>::generate_lattice_rows(int x_begin, std::size_t columns, int z, std::vector<float>& smoothed) {
+    auto constexpr rows = stencil_rows();
+    smoothed.resize(rows.size() * columns);
+
+    for(auto k = 0u; k < rows.size(); k++) {
+        for(auto c = 0u; c < columns; c++)
+            smoothed[k * columns + c] = generate_smooth_noise(x_begin + static_cast<int>(c), z + rows[k]);
+    }
+}
+
+template <InterpolationMethod IM>
+void HeightGenerator<IM>::generate_vector_coefficients(std::vector<float> const& smoothed, std::size_t columns, std::size_t cells, std::vector<float>& coefficients) {
+    using simd_interpolation::COEFFICIENTS;
+    auto constexpr rows = stencil_rows();
+    coefficients.resize(rows.size() * COEFFICIENTS * cells);
+
+    for(auto k = 0u; k < rows.size(); k++) {
+        float const* row = &smoothed[k * columns];
+        float* a = &coefficients[(COEFFICIENTS * k) * cells];
+        float* b = a + cells;
+        float* c = b + cells;
+        float* d = c + cells;
+        for(auto i = 0u; i < cells; i++)
+            simd_interpolation::cubic_coefficients(row[i], row[i+1], row[i+2], row[i+3], a + i, b + i, c + i, d + i);
+    }
+}
+
+/* Lattice rows, relative to the row of the sample, read by interpolated_noise. The bicubic stencil
+ * reads row z + 1 twice, this is mirrored here to keep generated terrain unchanged */
+template <InterpolationMethod IM>
+auto constexpr HeightGenerator<IM>::stencil_rows() {
+    if constexpr(IM == InterpolationMethod::Bicubic)
+        return std::array<int, 4>{ -1, 0, 1, 1 };
+    else
+        return std::array<int, 2>{ 0, 1 };
+}
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t HeightGenerator<IM>::compute_frequencies() {
+    octave_array_t frequencies;
+    float divisor = std::pow(2.f, OCTAVES-1u);
+    for(auto i = 0u; i < OCTAVES; i++)
+        frequencies[i] = std::pow(2.f, i) / divisor;
+
+    return frequencies;
+}
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t HeightGenerator<IM>::compute_amplitudes() {
+    octave_array_t amplitudes;
+    for(auto i = 0u; i < OCTAVES; i++)
+        amplitudes[i] = std::pow(ROUGHNESS, i);
+
+    return amplitudes;
+}
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t const HeightGenerator<IM>::frequencies_ = compute_frequencies();
+
+template <InterpolationMethod IM>
+typename HeightGenerator<IM>::octave_array_t const HeightGenerator<IM>::amplitudes_ = compute_amplitudes();
+
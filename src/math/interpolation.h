@@ -18,9 +18,26 @@ namespace interpolation{
 	template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<T>>>>
 	std::decay_t<T> linear(T x, T min = static_cast<T>(0.0), T max = static_cast<T>(1.0));
 
+    /* Coefficients of the cubic polynomial through p0, p1, p2 and p3, in descending order. May be computed
+     * once and reused when interpolating between the same four points repeatedly */
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<std::decay_t<T>>>>
+    struct CubicCoefficients {
+        using value_type = std::common_type_t<std::decay_t<T>, double>;
+        value_type a;
+        value_type b;
+        value_type c;
+        value_type d;
+    };
+
     template <typename T, typename = std::enable_if_t<std::is_floating_point_v<std::decay_t<T>>>>
     std::decay_t<T> cubic(T x, T p0, T p1, T p2, T p3);
 
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<std::decay_t<T>>>>
+    std::decay_t<T> cubic(T x, CubicCoefficients<T> const& coeffs);
+
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<std::decay_t<T>>>>
+    CubicCoefficients<T> cubic_coefficients(T p0, T p1, T p2, T p3);
+
 	template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<T>>>>
 	Parameters<T> polar(T angle, T radius = static_cast<T>(1.0));
 
@@ -6,9 +6,20 @@ std::decay_t<T> interpolation::linear(T x, T min, T max){
 
 template <typename T, typename>
 std::decay_t<T> interpolation::cubic(T x, T p0, T p1, T p2, T p3) {
-    return (-0.5 * p0 + 1.5 * p1 - 1.5 * p2 + 0.5 * p3) * std::pow(x, 3.0) +
-           (p0 - 2.5 * p1 + 2 * p2 - 0.5 * p3) * std::pow(x, 2.0) + 
-           (-0.5 * p0 + 0.5 * p2) * x + p1;
+    return cubic(x, cubic_coefficients(p0, p1, p2, p3));
+}
+
+template <typename T, typename>
+std::decay_t<T> interpolation::cubic(T x, CubicCoefficients<T> const& coeffs) {
+    return coeffs.a * std::pow(x, 3.0) + coeffs.b * std::pow(x, 2.0) + coeffs.c * x + coeffs.d;
+}
+
+template <typename T, typename>
+interpolation::CubicCoefficients<T> interpolation::cubic_coefficients(T p0, T p1, T p2, T p3) {
+    return { -0.5 * p0 + 1.5 * p1 - 1.5 * p2 + 0.5 * p3,
+             p0 - 2.5 * p1 + 2 * p2 - 0.5 * p3,
+             -0.5 * p0 + 0.5 * p2,
+             p1 };
 }
 
 template <typename T, typename>
@@ -0,0 +1,63 @@
+#include "lattice_cache.h"
+#include <algorithm>
+#include <cmath>
+
+LatticeCache::LatticeCache() : values_(SLOTS * TILE_AREA, EMPTY) { }
+
+float& LatticeCache::at(int x, int z) {
+	/* Local coordinates are always non-negative, subtracting them yields a multiple of TILE_SIZE
+	 * that cannot overflow, making the division exact for any 32-bit coordinate */
+	int const local_x = x & TILE_MASK;
+	int const local_z = z & TILE_MASK;
+	int const tile_x  = (x - local_x) / TILE_SIZE;
+	int const tile_z  = (z - local_z) / TILE_SIZE;
+
+	float* tile = find(tile_x, tile_z);
+
+	return tile[static_cast<std::size_t>(local_z) * TILE_SIZE + static_cast<std::size_t>(local_x)];
+}
+
+void LatticeCache::clear() noexcept {
+	for(auto& key : keys_)
+		key.resident = false;
+}
+
+bool LatticeCache::is_empty(float value) noexcept {
+	return std::isnan(value);
+}
+
+float* LatticeCache::find(int tile_x, int tile_z) noexcept {
+	std::size_t const first = set_index(tile_x, tile_z) * WAYS;
+	std::size_t victim = first;
+
+	clock_++;
+	for(auto slot = first; slot < first + WAYS; slot++) {
+		auto& key = keys_[slot];
+		if(key.resident && key.x == tile_x && key.z == tile_z) {
+			key.last_use = clock_;
+			return &values_[slot * TILE_AREA];
+		}
+
+		/* Prefer unused slots, otherwise evict the least recently used tile */
+		if(!key.resident)
+			victim = slot;
+		else if(keys_[victim].resident && clock_ - key.last_use > clock_ - keys_[victim].last_use)
+			victim = slot;
+	}
+
+	return claim(victim, tile_x, tile_z);
+}
+
+float* LatticeCache::claim(std::size_t slot, int tile_x, int tile_z) noexcept {
+	keys_[slot] = { tile_x, tile_z, clock_, true };
+
+	float* tile = &values_[slot * TILE_AREA];
+	std::fill(tile, tile + TILE_AREA, EMPTY);
+	return tile;
+}
+
+std::size_t LatticeCache::set_index(int tile_x, int tile_z) noexcept {
+	std::uint32_t const hash = static_cast<std::uint32_t>(tile_x) * 0x9e3779b1u ^ 
+							   static_cast<std::uint32_t>(tile_z) * 0x85ebca77u;
+	return static_cast<std::size_t>((hash ^ (hash >> 16u)) % SETS);
+}
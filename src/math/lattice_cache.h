@@ -0,0 +1,54 @@
+#ifndef LATTICE_CACHE_H
+#define LATTICE_CACHE_H
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/* Dense cache for values sampled on an integer lattice. The lattice is split into square tiles of
+ * TILE_SIZE x TILE_SIZE values, each of which is stored contiguously. Tiles are hashed on their
+ * position to one of SETS sets, each holding up to WAYS tiles. When a set is full, the least recently
+ * used tile is evicted, bounding memory usage regardless of the extent of the lattice.
+ *
+ * Values are filled lazily. at(x, z) returns a reference to the value at (x, z), which is EMPTY until
+ * assigned by the caller */
+class LatticeCache {
+	public:
+		LatticeCache();
+
+		float& at(int x, int z);
+		void clear() noexcept;
+
+		static bool is_empty(float value) noexcept;
+
+		static int constexpr TILE_SHIFT = 6;
+		static int constexpr TILE_SIZE = 1 << TILE_SHIFT;
+		static std::size_t constexpr SETS = 64u;
+		static std::size_t constexpr WAYS = 4u;
+		static float constexpr EMPTY = std::numeric_limits<float>::quiet_NaN();
+	private:
+		struct TileKey {
+			int x;
+			int z;
+			std::uint32_t last_use;
+			bool resident;
+		};
+
+		static int constexpr TILE_MASK = TILE_SIZE - 1;
+		static std::size_t constexpr TILE_AREA = TILE_SIZE * TILE_SIZE;
+		static std::size_t constexpr SLOTS = SETS * WAYS;
+
+		std::array<TileKey, SLOTS> keys_{};
+		std::vector<float> values_;
+		std::uint32_t clock_{0u};
+
+		float* find(int tile_x, int tile_z) noexcept;
+		float* claim(std::size_t slot, int tile_x, int tile_z) noexcept;
+
+		static std::size_t set_index(int tile_x, int tile_z) noexcept;
+};
+
+#endif
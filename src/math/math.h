@@ -5,6 +5,7 @@
 #include "constants.h"
 #include "exception.h"
 #include "traits.h"
+#include <cstdint>
 #include <type_traits>
 
 namespace math {
@@ -17,6 +18,10 @@ namespace math {
     template <typename T>
     std::decay_t<T> gcd(T num, T den);
 
+    /* Stateless integer hashes, the same input always yields the same, well mixed output */
+    std::uint32_t constexpr hash(std::uint32_t value) noexcept;
+    std::uint32_t constexpr hash(std::uint32_t seed, std::int32_t x, std::int32_t z) noexcept;
+
     namespace angle {
         double to_radians(double degrees);
         double to_degrees(double radians);
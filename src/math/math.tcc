@@ -37,3 +37,18 @@ std::decay_t<T> gcd(T num, T den) {
 
     return num;
 }
+
+/* Chris Wellons' lowbias32 */
+std::uint32_t constexpr math::hash(std::uint32_t value) noexcept {
+    value ^= value >> 16u;
+    value *= 0x7feb352du;
+    value ^= value >> 15u;
+    value *= 0x846ca68bu;
+    value ^= value >> 16u;
+    return value;
+}
+
+std::uint32_t constexpr math::hash(std::uint32_t seed, std::int32_t x, std::int32_t z) noexcept {
+    /* Unsigned arithmetic keeps the result well-defined for any coordinate */
+    return hash(static_cast<std::uint32_t>(x) + hash(static_cast<std::uint32_t>(z) + hash(seed)));
+}
@@ -0,0 +1,187 @@
+#include "simd_interpolation.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_INTERPOLATION_X86
+#include <immintrin.h>
+#endif
+
+namespace simd_interpolation {
+    float cubic(float x, float a, float b, float c, float d) noexcept;
+
+    void bicubic_row_scalar(std::size_t begin, std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                            float const* coefficients, std::size_t stride, float amp, float* out) noexcept;
+
+    #ifdef SIMD_INTERPOLATION_X86
+    __attribute__((target("sse2")))
+    std::size_t bicubic_row_sse2(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                 float const* coefficients, std::size_t stride, float amp, float* out) noexcept;
+
+    __attribute__((target("avx2")))
+    std::size_t bicubic_row_avx2(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                 float const* coefficients, std::size_t stride, float amp, float* out) noexcept;
+    #endif
+
+    InstructionSet detect_instruction_set() noexcept;
+}
+
+simd_interpolation::InstructionSet simd_interpolation::instruction_set() noexcept {
+    static InstructionSet const set = detect_instruction_set();
+    return set;
+}
+
+void simd_interpolation::bicubic_row(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                     float const* coefficients, std::size_t stride, float amp, float* out) noexcept {
+    bicubic_row(instruction_set(), count, rem_x, cells, rem_z, coefficients, stride, amp, out);
+}
+
+void simd_interpolation::bicubic_row(InstructionSet set, std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                     float const* coefficients, std::size_t stride, float amp, float* out) noexcept {
+    std::size_t done = 0u;
+
+    #ifdef SIMD_INTERPOLATION_X86
+    if(set == InstructionSet::AVX2)
+        done = bicubic_row_avx2(count, rem_x, cells, rem_z, coefficients, stride, amp, out);
+    else if(set == InstructionSet::SSE2)
+        done = bicubic_row_sse2(count, rem_x, cells, rem_z, coefficients, stride, amp, out);
+    #else
+    (void)set;
+    #endif
+
+    /* Remaining samples not filling an entire register */
+    bicubic_row_scalar(done, count, rem_x, cells, rem_z, coefficients, stride, amp, out);
+}
+
+void simd_interpolation::cubic_coefficients(float p0, float p1, float p2, float p3, float* a, float* b, float* c, float* d) noexcept {
+    *a = -0.5f * p0 + 1.5f * p1 - 1.5f * p2 + 0.5f * p3;
+    *b = p0 - 2.5f * p1 + 2.f * p2 - 0.5f * p3;
+    *c = -0.5f * p0 + 0.5f * p2;
+    *d = p1;
+}
+
+float simd_interpolation::cubic(float x, float a, float b, float c, float d) noexcept {
+    return ((a * x + b) * x + c) * x + d;
+}
+
+void simd_interpolation::bicubic_row_scalar(std::size_t begin, std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                            float const* coefficients, std::size_t stride, float amp, float* out) noexcept {
+    for(auto i = begin; i < count; i++) {
+        float rows[STENCIL_ROWS];
+        for(auto k = 0u; k < STENCIL_ROWS; k++) {
+            float const* row = coefficients + COEFFICIENTS * k * stride + cells[i];
+            rows[k] = cubic(rem_x[i], row[0], row[stride], row[2u * stride], row[3u * stride]);
+        }
+
+        float a, b, c, d;
+        cubic_coefficients(rows[0], rows[1], rows[2], rows[3], &a, &b, &c, &d);
+        out[i] += cubic(rem_z, a, b, c, d) * amp;
+    }
+}
+
+#ifdef SIMD_INTERPOLATION_X86
+__attribute__((target("sse2")))
+std::size_t simd_interpolation::bicubic_row_sse2(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                                 float const* coefficients, std::size_t stride, float amp, float* out) noexcept {
+    std::size_t constexpr WIDTH = 4u;
+
+    __m128 const z     = _mm_set1_ps(rem_z);
+    __m128 const scale = _mm_set1_ps(amp);
+    __m128 const half  = _mm_set1_ps(0.5f);
+    __m128 const neg_half = _mm_set1_ps(-0.5f);
+    __m128 const one_and_half = _mm_set1_ps(1.5f);
+    __m128 const two   = _mm_set1_ps(2.f);
+    __m128 const two_and_half = _mm_set1_ps(2.5f);
+
+    auto const gather = [](float const* base, std::int32_t const* idx) {
+        return _mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]);
+    };
+
+    std::size_t i = 0u;
+    for(; i + WIDTH <= count; i += WIDTH) {
+        __m128 const x = _mm_loadu_ps(rem_x + i);
+        __m128 rows[STENCIL_ROWS];
+
+        for(auto k = 0u; k < STENCIL_ROWS; k++) {
+            float const* row = coefficients + COEFFICIENTS * k * stride;
+            __m128 r = gather(row, cells + i);
+            r = _mm_add_ps(_mm_mul_ps(r, x), gather(row + stride, cells + i));
+            r = _mm_add_ps(_mm_mul_ps(r, x), gather(row + 2u * stride, cells + i));
+            r = _mm_add_ps(_mm_mul_ps(r, x), gather(row + 3u * stride, cells + i));
+            rows[k] = r;
+        }
+
+        __m128 const a = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(neg_half, rows[0]), _mm_mul_ps(one_and_half, rows[1])), 
+                                               _mm_mul_ps(one_and_half, rows[2])), 
+                                    _mm_mul_ps(half, rows[3]));
+        __m128 const b = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(rows[0], _mm_mul_ps(two_and_half, rows[1])), 
+                                               _mm_mul_ps(two, rows[2])), 
+                                    _mm_mul_ps(half, rows[3]));
+        __m128 const c = _mm_add_ps(_mm_mul_ps(neg_half, rows[0]), _mm_mul_ps(half, rows[2]));
+
+        __m128 h = _mm_add_ps(_mm_mul_ps(a, z), b);
+        h = _mm_add_ps(_mm_mul_ps(h, z), c);
+        h = _mm_add_ps(_mm_mul_ps(h, z), rows[1]);
+
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(h, scale)));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t simd_interpolation::bicubic_row_avx2(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                                                 float const* coefficients, std::size_t stride, float amp, float* out) noexcept {
+    std::size_t constexpr WIDTH = 8u;
+
+    __m256 const z     = _mm256_set1_ps(rem_z);
+    __m256 const scale = _mm256_set1_ps(amp);
+    __m256 const half  = _mm256_set1_ps(0.5f);
+    __m256 const neg_half = _mm256_set1_ps(-0.5f);
+    __m256 const one_and_half = _mm256_set1_ps(1.5f);
+    __m256 const two   = _mm256_set1_ps(2.f);
+    __m256 const two_and_half = _mm256_set1_ps(2.5f);
+
+    std::size_t i = 0u;
+    for(; i + WIDTH <= count; i += WIDTH) {
+        __m256 const x = _mm256_loadu_ps(rem_x + i);
+        __m256i const idx = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(cells + i));
+        __m256 rows[STENCIL_ROWS];
+
+        for(auto k = 0u; k < STENCIL_ROWS; k++) {
+            float const* row = coefficients + COEFFICIENTS * k * stride;
+            __m256 r = _mm256_i32gather_ps(row, idx, sizeof(float));
+            r = _mm256_add_ps(_mm256_mul_ps(r, x), _mm256_i32gather_ps(row + stride, idx, sizeof(float)));
+            r = _mm256_add_ps(_mm256_mul_ps(r, x), _mm256_i32gather_ps(row + 2u * stride, idx, sizeof(float)));
+            r = _mm256_add_ps(_mm256_mul_ps(r, x), _mm256_i32gather_ps(row + 3u * stride, idx, sizeof(float)));
+            rows[k] = r;
+        }
+
+        __m256 const a = _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(neg_half, rows[0]), _mm256_mul_ps(one_and_half, rows[1])), 
+                                                     _mm256_mul_ps(one_and_half, rows[2])), 
+                                       _mm256_mul_ps(half, rows[3]));
+        __m256 const b = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(rows[0], _mm256_mul_ps(two_and_half, rows[1])), 
+                                                     _mm256_mul_ps(two, rows[2])), 
+                                       _mm256_mul_ps(half, rows[3]));
+        __m256 const c = _mm256_add_ps(_mm256_mul_ps(neg_half, rows[0]), _mm256_mul_ps(half, rows[2]));
+
+        __m256 h = _mm256_add_ps(_mm256_mul_ps(a, z), b);
+        h = _mm256_add_ps(_mm256_mul_ps(h, z), c);
+        h = _mm256_add_ps(_mm256_mul_ps(h, z), rows[1]);
+
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(h, scale)));
+    }
+
+    return i;
+}
+#endif
+
+simd_interpolation::InstructionSet simd_interpolation::detect_instruction_set() noexcept {
+    #ifdef SIMD_INTERPOLATION_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        return InstructionSet::AVX2;
+    if(__builtin_cpu_supports("sse2"))
+        return InstructionSet::SSE2;
+    #endif
+
+    return InstructionSet::Scalar;
+}
@@ -0,0 +1,41 @@
+#ifndef SIMD_INTERPOLATION_H
+#define SIMD_INTERPOLATION_H
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/* Vectorized bicubic interpolation of rows of samples. The instruction set is detected at runtime, using AVX2
+ * (8 samples at a time) where available and SSE2 (4 samples at a time) otherwise. The scalar path is the
+ * reference implementation, all paths perform the same single precision operations in the same order and
+ * produce identical results.
+ *
+ * The kernels evaluate the cubic polynomials using Horner's method in single precision, whereas
+ * interpolation::cubic evaluates them using std::pow in double precision. For heights generated by
+ * HeightGenerator, the results differ by no more than TOLERANCE times the amplitude of the generator */
+namespace simd_interpolation {
+    enum class InstructionSet { Scalar, SSE2, AVX2 };
+
+    /* Number of lattice rows read per sample and number of coefficients per cubic */
+    std::size_t constexpr STENCIL_ROWS = 4u;
+    std::size_t constexpr COEFFICIENTS = 4u;
+
+    float constexpr TOLERANCE = 1e-6f;
+
+    InstructionSet instruction_set() noexcept;
+
+    /* For each i < count, accumulates amp * bicubic(rem_x[i], rem_z) into out[i]. The four cubics along
+     * x use the coefficients of lattice cell cells[i], stored in structure-of-arrays layout with the
+     * n:th coefficient (in descending order) of stencil row k at coefficients[(COEFFICIENTS*k + n) * stride + cells[i]] */
+    void bicubic_row(std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                     float const* coefficients, std::size_t stride, float amp, float* out) noexcept;
+
+    /* As above, but using the given instruction set. Must be supported by the CPU */
+    void bicubic_row(InstructionSet set, std::size_t count, float const* rem_x, std::int32_t const* cells, float rem_z,
+                     float const* coefficients, std::size_t stride, float amp, float* out) noexcept;
+
+    /* Coefficients of the cubic polynomial through p0, p1, p2 and p3 in single precision */
+    void cubic_coefficients(float p0, float p1, float p2, float p3, float* a, float* b, float* c, float* d) noexcept;
+}
+
+#endif
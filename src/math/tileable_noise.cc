@@ -1,30 +1,36 @@
 #include "constants.h"
+#include "math.h"
 #include "tileable_noise.h"
 #include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cmath>
+#include <cstdint>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <numeric>
-#include <random>
+#include <utility>
 
 namespace tileable_noise {
     float fade(float t);
     float surflet(float x, float y, int grid_x, int grid_y, unsigned period);
-    std::array<GLuint, 512> permutate();
+    std::array<GLuint, 512> permutate(std::uint32_t seed);
     std::array<glm::vec2, 256> compute_directions();
 
     std::array<GLuint, 512> permutation{};
     std::array<glm::vec2, 256> directions{};
 
     bool first_call{true};
+    std::uint32_t permutation_seed{};
 }
 
-float tileable_noise::generate(float x, float y, unsigned period) {
-    if(first_call) {
-        permutation = permutate();
+float tileable_noise::generate(float x, float y, unsigned period, std::uint32_t seed) {
+    if(first_call)
         directions = compute_directions();
+
+    if(first_call || seed != permutation_seed) {
+        permutation = permutate(seed);
+        permutation_seed = seed;
         first_call = false;
     }
 
@@ -54,10 +60,15 @@ float tileable_noise::surflet(float x, float y, int grid_x, int grid_y, unsigned
 }
 
 
-std::array<GLuint, 512> tileable_noise::permutate() {
+std::array<GLuint, 512> tileable_noise::permutate(std::uint32_t seed) {
     std::array<GLuint, 256> p;
     std::iota(std::begin(p), std::end(p), 0u);
-    std::shuffle(std::begin(p), std::end(p), std::mt19937{std::random_device{}()});
+
+    /* Fisher-Yates driven by math::hash, std::shuffle is not guaranteed to give the same order across standard libraries */
+    for(auto i = p.size() - 1u; i > 0u; i--) {
+        auto const j = math::hash(seed, static_cast<std::int32_t>(i), 0) % (i + 1u);
+        std::swap(p[i], p[j]);
+    }
 
     std::array<GLuint, 512> perm;
     auto it = std::begin(perm);
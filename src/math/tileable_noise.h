@@ -3,11 +3,15 @@
 
 #pragma once
 #include "texture.h"
+#include <cstdint>
 
 
 namespace tileable_noise {
 
-    float generate(float x, float y, unsigned period);
+    std::uint32_t constexpr DEFAULT_SEED = 0x5eedu;
+
+    /* Noise with the given seed, repeating every period units along both axes */
+    float generate(float x, float y, unsigned period, std::uint32_t seed = DEFAULT_SEED);
 
 }
 
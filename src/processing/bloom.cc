@@ -2,7 +2,7 @@
 #include "texture.h"
 #include "viewport.h"
 
-Bloom::Bloom(int width, int height) : shader_{"assets/shaders/bloom.vert", Shader::Type::Vertex, "assets/shaders/bloom.frag", Shader::Type::Fragment}, fb_{static_cast<float>(width) / static_cast<float>(Viewport::width), static_cast<float>(height) / static_cast<float>(Viewport::height)} { } 
+Bloom::Bloom(int width, int height) : shader_{"assets/shaders/bloom.vert", Shader::Type::Vertex, "assets/shaders/bloom.frag", Shader::Type::Fragment}, clear_color_uniform_{shader_.uniform<glm::vec4>(CLEAR_COLOR_UNIFORM_NAME)}, fb_{static_cast<float>(width) / static_cast<float>(Viewport::width), static_cast<float>(height) / static_cast<float>(Viewport::height)} { } 
 
 void Bloom::apply(GLuint texture) const {
     Texture::bind(texture);
@@ -21,7 +21,7 @@ std::array<GLuint, 2> Bloom::texture_ids() const {
 
 void Bloom::upload_clear_color() const {
     glGetFloatv(GL_COLOR_CLEAR_VALUE, &clear_color_[0]);
-    shader_.upload_uniform(CLEAR_COLOR_UNIFORM_NAME, clear_color_);
+    shader_.upload_uniform(clear_color_uniform_, clear_color_);
 }
 
 std::string const Bloom::CLEAR_COLOR_UNIFORM_NAME{"clear_col"};
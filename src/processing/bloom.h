@@ -21,6 +21,7 @@ class Bloom {
 
     private:
         Shader shader_;
+        Shader::Uniform<glm::vec4> clear_color_uniform_;
         Framebuffer_ fb_;
         mutable glm::vec4 clear_color_{};
 
@@ -29,6 +29,7 @@ namespace impl {
 
         private:
             Shader shader_;
+            Shader::Uniform<float> dim_uniform_;
             float width_ratio_{}, height_ratio_{};
             Framebuffer_ fb_;
 
@@ -1,6 +1,6 @@
 
 template <impl::Direction dir>
-impl::Blur<dir>::Blur(int width, int height) : shader_{"assets/shaders/blur.vert", Shader::Type::Vertex, "assets/shaders/blur.frag", Shader::Type::Fragment}, width_ratio_{static_cast<float>(width) / static_cast<float>(Viewport::width)}, height_ratio_{static_cast<float>(height) / static_cast<float>(Viewport::height)}, fb_{static_cast<float>(width) / static_cast<float>(Viewport::width), static_cast<float>(height) / static_cast<float>(Viewport::height)} { 
+impl::Blur<dir>::Blur(int width, int height) : shader_{"assets/shaders/blur.vert", Shader::Type::Vertex, "assets/shaders/blur.frag", Shader::Type::Fragment}, dim_uniform_{shader_.uniform<float>("ufrm_dim")}, width_ratio_{static_cast<float>(width) / static_cast<float>(Viewport::width)}, height_ratio_{static_cast<float>(height) / static_cast<float>(Viewport::height)}, fb_{static_cast<float>(width) / static_cast<float>(Viewport::width), static_cast<float>(height) / static_cast<float>(Viewport::height)} { 
     init();
 }
 
@@ -39,11 +39,11 @@ void impl::Blur<dir>::init() {
 
     if constexpr(dir == Direction::Vertical) {
         shader_.upload_uniform("ufrm_direction", VERTICAL);
-        shader_.upload_uniform("ufrm_dim", height_ratio_ * static_cast<float>(Viewport::height));
+        shader_.upload_uniform(dim_uniform_, height_ratio_ * static_cast<float>(Viewport::height));
     }
     else {
         shader_.upload_uniform("ufrm_direction", HORIZONTAL);
-        shader_.upload_uniform("ufrm_dim", width_ratio_ * static_cast<float>(Viewport::width));
+        shader_.upload_uniform(dim_uniform_, width_ratio_ * static_cast<float>(Viewport::width));
     }
     float x_scale = 1.f / width_ratio_;
     float y_scale = 1.f / height_ratio_;
@@ -54,9 +54,9 @@ void impl::Blur<dir>::init() {
 template <impl::Direction dir>
 void impl::Blur<dir>::resize() const {
     if constexpr(dir == Direction::Vertical) 
-        shader_.upload_uniform("ufrm_dim", height_ratio_ * static_cast<float>(Viewport::height));
+        shader_.upload_uniform(dim_uniform_, height_ratio_ * static_cast<float>(Viewport::height));
     else 
-        shader_.upload_uniform("ufrm_dim", width_ratio_ * static_cast<float>(Viewport::width));
+        shader_.upload_uniform(dim_uniform_, width_ratio_ * static_cast<float>(Viewport::width));
 }
 
 template <impl::Direction dir>
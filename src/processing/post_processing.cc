@@ -1,3 +1,4 @@
+#include "gpu_profiler.h"
 #include "post_processing.h"
 #include "texture.h"
 #include "viewport.h"
@@ -8,21 +9,29 @@ PostProcessing::PostProcessing() : h_blur_{Viewport::width / 16, Viewport::heigh
 void PostProcessing::perform() const {
     canvas_.bind();
     auto scene = Shader::scene_texture();
+    gpu_profiler::begin("bloom");
     bloom_.apply(scene);
     canvas_.draw();
+    gpu_profiler::end();
 
     auto to_blur = bloom_.texture_ids()[1];
     for(auto i = 0u; i < NUM_BLUR_PASSES; i++) {
+        gpu_profiler::begin(BLUR_PASS_NAMES[2u * i]);
         h_blur_.apply(to_blur);
         canvas_.draw();
+        gpu_profiler::end();
 
+        gpu_profiler::begin(BLUR_PASS_NAMES[2u * i + 1u]);
         v_blur_.apply(h_blur_.texture_id());
         canvas_.draw();
+        gpu_profiler::end();
 
         to_blur = v_blur_.texture_id();
     }
+    gpu_profiler::begin("mix");
     mix_.apply(bloom_.texture_ids()[0], v_blur_.texture_id());
     canvas_.draw();
+    gpu_profiler::end();
     canvas_.unbind();
 
     Texture::bind(mix_.texture_id());
@@ -32,4 +41,14 @@ bool PostProcessing::enabled() {
     return instantiated_;
 }
 
+std::array<std::string, 2u * PostProcessing::NUM_BLUR_PASSES> PostProcessing::blur_pass_names() {
+    std::array<std::string, 2u * NUM_BLUR_PASSES> names;
+    for(auto i = 0u; i < NUM_BLUR_PASSES; i++) {
+        names[2u * i]      = "blur_horizontal_" + std::to_string(i);
+        names[2u * i + 1u] = "blur_vertical_" + std::to_string(i);
+    }
+    return names;
+}
+
 bool PostProcessing::instantiated_{false};
+std::array<std::string, 2u * PostProcessing::NUM_BLUR_PASSES> const PostProcessing::BLUR_PASS_NAMES = blur_pass_names();
@@ -9,6 +9,9 @@
 #include "shader.h"
 #include "shader_handler.h"
 #include "viewport.h"
+#include <array>
+#include <cstddef>
+#include <string>
 
 class PostProcessing {
     public:
@@ -27,6 +30,10 @@ class PostProcessing {
         Canvas<manual_shader_handler> canvas_{};
     
         static bool instantiated_;
+
+        /* Names of the horizontal and vertical blur passes, interleaved, as reported to gpu_profiler */
+        static std::array<std::string, 2u * NUM_BLUR_PASSES> const BLUR_PASS_NAMES;
+        static std::array<std::string, 2u * NUM_BLUR_PASSES> blur_pass_names();
 };
 
 #endif
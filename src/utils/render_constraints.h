@@ -50,8 +50,8 @@ struct indices_is_applicable_c_array : std::false_type { };
 
 template <typename T>
 struct indices_is_applicable_c_array<T, std::void_t<decltype(std::declval<T>().indices()), decltype(std::declval<T>().indices_size())>>
-: std::bool_constant<std::is_pointer_v<decltype(std::declval<T>().indices_size())> && 
-					 std::is_arithmetic_v<fundamental_type_t<decltype(std::declval<T>().indices_size())>> &&
+: std::bool_constant<std::is_pointer_v<decltype(std::declval<T>().indices())> && 
+					 std::is_integral_v<fundamental_type_t<decltype(std::declval<T>().indices())>> &&
 					 std::is_integral_v<remove_cvref_t<decltype(std::declval<T>().indices_size())>>> { };
 
 template <typename T>